@@ -2,8 +2,9 @@
 ミニマックス探索
 */
 
-#include <array>
+#include <random>
 
+#include "games/match_runner.hpp"
 #include "games/play.hpp"
 #include "games/othello.hpp"
 
@@ -51,10 +52,13 @@ Action mini_max_action(const State& state, const int depth) {
 }
 
 int main() {
-    std::array<play::Player<State, Action>, 2> players = {
-        [](const State& state) { return mini_max_action(state, 3); },
-        [](const State& state) { return random_action(state); },
-    };
-    play::test_ai(players, 100);
+    // ゲームをスレッドに分配して並列に対戦する. ランダムプレイヤーの乱数はゲームごとの種から作る
+    play::MatchOptions options;
+    options.game_number = 100;
+    const auto result = play::run_match<State>(
+        [](uint64_t) { return [](const State& state) { return mini_max_action(state, 3); }; },
+        [](uint64_t seed) { return [engine = std::mt19937(seed)](const State& state) mutable { return random_action(state, engine); }; },
+        options);
+    play::print_match_result(result, options);
     return 0;
 }
\ No newline at end of file
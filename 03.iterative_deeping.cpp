@@ -1,8 +1,13 @@
 /*
 反復深化アルファベータ探索
+時間切れで中断した反復でも, 探索を終えたルートの手が前回の最善手より良ければ採用する
+また, 反復ごとの探索時間を実効分岐数から予測し, 終わらない反復は開始しない
 */
 
+#include <algorithm>
 #include <array>
+#include <iostream>
+#include <random>
 
 #include "games/play.hpp"
 #include "games/othello.hpp"
@@ -15,6 +20,25 @@ using othello::random_action;
 using othello::score::ScoreType;
 using othello::score::INF;
 
+// 1 反復分の探索結果
+// is_completed が false なら時間切れで中断しており, best_action は探索を終えたルートの手の中での最善手
+struct SearchResult {
+    Action best_action = othello::NO_POS;
+    ScoreType best_score = -INF;
+    int completed_action_count = 0;
+    int action_count = 0;
+    bool is_completed = false;
+};
+
+// 深さあたりの時間効率の計測用
+struct SearchStatistics {
+    int64_t move_count = 0;
+    double sum_effective_depth = 0;
+    int64_t sum_elapsed_microseconds = 0;
+};
+
+static SearchStatistics statistics;
+
 ScoreType alphabeta_score(const State& state, ScoreType alpha, const ScoreType beta, const int depth, const TimeKeeper& time_keeper) {
     if (time_keeper.is_time_over()) {
         return 0;
@@ -43,47 +67,91 @@ ScoreType alphabeta_score(const State& state, ScoreType alpha, const ScoreType b
     return alpha;
 }
 
-Action alphabeta_action_with_time_threshold(const State& state, const int depth, const TimeKeeper& time_keeper) {
-    Action best_action = othello::NO_POS;
+// 前回の反復の最善手 first_action を最初に探索する
+// 中断された反復では, first_action より良いと確定した手だけが best_action に残る
+SearchResult alphabeta_action_with_time_threshold(const State& state, const int depth, const Action first_action, const TimeKeeper& time_keeper) {
+    SearchResult result;
     ScoreType alpha = -INF;
     ScoreType beta = INF;
     auto legal_actions = state.legal_actions();
+    if (auto it = std::find(legal_actions.begin(), legal_actions.end(), first_action); it != legal_actions.end()) {
+        std::rotate(legal_actions.begin(), it, it + 1);
+    }
+    result.action_count = legal_actions.size();
     for (const auto action : legal_actions) {
         State next_state = state;
         next_state.step(action);
         ScoreType score = -alphabeta_score(next_state, -beta, -alpha, depth, time_keeper);
+        // 時間切れで打ち切られた手の評価値は信用できないので捨てる
+        if (time_keeper.is_time_over()) {
+            return result;
+        }
+        ++result.completed_action_count;
         if (score > alpha) {
-            best_action = action;
+            result.best_action = action;
+            result.best_score = score;
             alpha = score;
         }
-        if (time_keeper.is_time_over()) {
-            return othello::NO_POS;
-        }
     }
-    return best_action;
+    result.is_completed = true;
+    return result;
 }
 
 Action iterative_deeping_action(const State& state, const int64_t time_threshold) {
     auto time_keeper = TimeKeeper(time_threshold);
     Action best_action = othello::NO_POS;
+    double effective_depth = 0;
+    // 直前 2 反復の所要時間 (マイクロ秒)
+    int64_t pre_iteration_time = 0;
+    int64_t last_iteration_time = 0;
     for (int depth = 1; ; ++depth) {
-        Action action = alphabeta_action_with_time_threshold(state, depth, time_keeper);
+        // 実効分岐数 = 直前 2 反復の所要時間の比 から次の反復の所要時間を予測し, 間に合わないなら打ち切る
+        if (pre_iteration_time > 0) {
+            const double branching_factor = std::max(1.0, static_cast<double>(last_iteration_time) / pre_iteration_time);
+            if (last_iteration_time * branching_factor > time_keeper.remaining_microseconds()) {
+                break;
+            }
+        }
 
-        if (time_keeper.is_time_over()) {
+        const int64_t iteration_start_time = time_keeper.elapsed_microseconds();
+        const auto result = alphabeta_action_with_time_threshold(state, depth, best_action, time_keeper);
+        if (result.best_action != othello::NO_POS) {
+            best_action = result.best_action;
+        }
+        if (!result.is_completed) {
+            if (result.action_count) {
+                effective_depth += static_cast<double>(result.completed_action_count) / result.action_count;
+            }
             break;
-        } else {
-            best_action = action;
         }
+        effective_depth = depth;
+        // 終局まで読み切ったら, それ以上深くしても結果は変わらない
+        if (depth >= state.count_empties()) {
+            break;
+        }
+        pre_iteration_time = last_iteration_time;
+        last_iteration_time = time_keeper.elapsed_microseconds() - iteration_start_time;
     }
+
+    ++statistics.move_count;
+    statistics.sum_effective_depth += effective_depth;
+    statistics.sum_elapsed_microseconds += time_keeper.elapsed_microseconds();
     return best_action;
 }
 
 int main() {
+    // 持ち時間で探索を打ち切るので, 並列に対戦すると CPU の取り合いで探索の深さが変わる. そのためゲームは逐次に行い,
+    // ランダムプレイヤーの乱数だけ種を固定する
     std::array<play::Player<State, Action>, 2> players = {
         [](const State& state) { return iterative_deeping_action(state, 10); },
         // [](const State& state) { return iterative_deeping_action(state, 1); },
-        [](const State& state) { return random_action(state); },
+        [engine = std::mt19937(0)](const State& state) mutable { return random_action(state, engine); },
     };
     play::test_ai(players, 100);
+
+    const double elapsed_milliseconds = statistics.sum_elapsed_microseconds / 1000.0;
+    std::cout << "Average depth\t" << statistics.sum_effective_depth / statistics.move_count << std::endl;
+    std::cout << "Average time [ms]\t" << elapsed_milliseconds / statistics.move_count << std::endl;
+    std::cout << "Depth per ms\t" << statistics.sum_effective_depth / elapsed_milliseconds << std::endl;
     return 0;
-}
\ No newline at end of file
+}
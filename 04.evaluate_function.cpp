@@ -80,6 +80,7 @@ Action iterative_deeping_action(const State& state, const int64_t time_threshold
 }
 
 int main() {
+    // 持ち時間で探索を打ち切るので, 並列に対戦すると CPU の取り合いで探索の深さが変わる. そのためゲームは逐次に行う
     std::array<play::Player<State, Action>, 2> players = {
         [](const State& state) { return iterative_deeping_action(state, 10, true); },
         [](const State& state) { return iterative_deeping_action(state, 10, false); },
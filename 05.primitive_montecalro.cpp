@@ -2,8 +2,10 @@
 原始モンテカルロ木探索
 */
 
-#include <array>
+#include <random>
+#include <vector>
 
+#include "games/match_runner.hpp"
 #include "games/play.hpp"
 #include "games/othello.hpp"
 
@@ -11,7 +13,7 @@ using State = othello::State;
 using Action = othello::Action;
 using othello::random_action;
 
-int playout(State& state) {
+int playout(State& state, std::mt19937& engine) {
     switch (state.get_winning_status()) {
     case WinningStatus::WIN:
         return 1;
@@ -19,12 +21,12 @@ int playout(State& state) {
     case WinningStatus::DRAW:
         return 0;
     default:
-        state.step(random_action(state));
-        return 1 - playout(state);
+        state.step(random_action(state, engine));
+        return 1 - playout(state, engine);
     }
 }
 
-Action primitive_montecalro_action(const State& state, int playout_number) {
+Action primitive_montecalro_action(const State& state, int playout_number, std::mt19937& engine) {
     auto legal_actions = state.legal_actions();
     int action_size = legal_actions.size();
     if (!action_size) {
@@ -37,7 +39,7 @@ Action primitive_montecalro_action(const State& state, int playout_number) {
 
         State next_state = state;
         next_state.step(legal_actions[action_idx]);
-        values[action_idx] += 1 - playout(next_state);
+        values[action_idx] += 1 - playout(next_state, engine);
         ++counts[action_idx];
     }
 
@@ -55,10 +57,13 @@ Action primitive_montecalro_action(const State& state, int playout_number) {
 }
 
 int main() {
-    std::array<play::Player<State, Action>, 2> players = {
-        [](const State& state) { return primitive_montecalro_action(state, 500); },
-        [](const State& state) { return random_action(state); },
-    };
-    play::test_ai(players, 100);
+    // ゲームをスレッドに分配して並列に対戦する. プレイアウトとランダムプレイヤーの乱数はゲームごとの種から作る
+    play::MatchOptions options;
+    options.game_number = 100;
+    const auto result = play::run_match<State>(
+        [](uint64_t seed) { return [engine = std::mt19937(seed)](const State& state) mutable { return primitive_montecalro_action(state, 500, engine); }; },
+        [](uint64_t seed) { return [engine = std::mt19937(seed)](const State& state) mutable { return random_action(state, engine); }; },
+        options);
+    play::print_match_result(result, options);
     return 0;
 }
\ No newline at end of file
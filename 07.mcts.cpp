@@ -2,9 +2,11 @@
 MCTS
 */
 
-#include <array>
 #include <cmath>
+#include <random>
+#include <vector>
 
+#include "games/match_runner.hpp"
 #include "games/play.hpp"
 #include "games/othello.hpp"
 
@@ -12,7 +14,7 @@ using othello::State;
 using othello::Action;
 using othello::random_action;
 
-int playout(State& state) {
+int playout(State& state, std::mt19937& engine) {
     switch (state.get_winning_status()) {
     case WinningStatus::WIN:
         return 1;
@@ -20,8 +22,8 @@ int playout(State& state) {
     case WinningStatus::DRAW:
         return 0;
     default:
-        state.step(random_action(state));
-        return 1 - playout(state);
+        state.step(random_action(state, engine));
+        return 1 - playout(state, engine);
     }
 }
 
@@ -41,7 +43,7 @@ public:
         }
     }
 
-    int evaluate() {
+    int evaluate(std::mt19937& engine) {
         int value = 0;
         if (state_.is_done()) {
             switch (state_.get_winning_status()) {
@@ -53,13 +55,13 @@ public:
             }
         } else if (child_nodes.empty()) {
             State state_copy = state_;
-            value = playout(state_copy);
+            value = playout(state_copy, engine);
 
             if (count == EXPAND_THRESHOLD) {
                 expand();
             }
         } else {
-            value = 1 - next_child_node().evaluate();
+            value = 1 - next_child_node().evaluate(engine);
         }
         win_ += value;
         ++count;
@@ -100,7 +102,7 @@ private:
     int win_;
 };
 
-Action mcts_action(const State& state, int playout_number) {
+Action mcts_action(const State& state, int playout_number, std::mt19937& engine) {
     auto legal_actions = state.legal_actions();
     int action_size = legal_actions.size();
     if (!action_size) {
@@ -109,7 +111,7 @@ Action mcts_action(const State& state, int playout_number) {
     Node root_node(state);
     root_node.expand();
     for (int t = 0; t < playout_number; ++t) {
-        root_node.evaluate();
+        root_node.evaluate(engine);
     }
     int best_action_idx = -1;
     int best_action_count = -1;
@@ -123,11 +125,14 @@ Action mcts_action(const State& state, int playout_number) {
 }
 
 int main() {
-    std::array<play::Player<State, Action>, 2> players = {
-        // [](const State& state) { return mcts_action(state, 1000); },
-        [](const State& state) { return mcts_action(state, 500); },
-        [](const State& state) { return random_action(state); },
-    };
-    play::test_ai(players, 100);
+    // ゲームをスレッドに分配して並列に対戦する. プレイアウトとランダムプレイヤーの乱数はゲームごとの種から作る
+    play::MatchOptions options;
+    options.game_number = 100;
+    const auto result = play::run_match<State>(
+        // [](uint64_t seed) { return [engine = std::mt19937(seed)](const State& state) mutable { return mcts_action(state, 1000, engine); }; },
+        [](uint64_t seed) { return [engine = std::mt19937(seed)](const State& state) mutable { return mcts_action(state, 500, engine); }; },
+        [](uint64_t seed) { return [engine = std::mt19937(seed)](const State& state) mutable { return random_action(state, engine); }; },
+        options);
+    play::print_match_result(result, options);
     return 0;
 }
\ No newline at end of file
@@ -4,16 +4,15 @@
 */
 
 #include <iostream>
-#include <unordered_map>
 
 #include "games/play.hpp"
 #include "games/tic_tac_toe.hpp"
+#include "utils/transposition_table.hpp"
 
 using State = tic_tac_toe::State;
 using Action = tic_tac_toe::Action;
 
-using tic_tac_toe::zobrist_hashing::HashValue;
-std::unordered_map<HashValue, int> state_values;
+TranspositionTable<int> state_values(1);
 
 static int node_count = 0;
 
@@ -30,7 +29,7 @@ int dfs(const State& state, const bool eliminate_same_position) {
             state_value = 0;
         }
         if (eliminate_same_position) {
-            state_values[state.hash_value] = state_value;
+            state_values.store(state.hash_value, state_value);
         }
         return state_value;
     }
@@ -38,7 +37,7 @@ int dfs(const State& state, const bool eliminate_same_position) {
     for (const auto action : legal_actions) {
         State next_state = state;
         next_state.step(action);
-        if (eliminate_same_position && state_values.contains(next_state.hash_value)) {
+        if (eliminate_same_position && state_values.find(next_state.hash_value) != nullptr) {
             continue;
         }
         int value = -dfs(next_state, eliminate_same_position);
@@ -47,7 +46,7 @@ int dfs(const State& state, const bool eliminate_same_position) {
         }
     }
     if (eliminate_same_position) {
-        state_values[state.hash_value] = state_value;
+        state_values.store(state.hash_value, state_value);
     }
     return state_value;
 }
@@ -2,9 +2,9 @@
 AND/OR 木探索
 */
 
-#include <array>
 #include <random>
 
+#include "games/match_runner.hpp"
 #include "games/play.hpp"
 #include "games/tic_tac_toe.hpp"
 
@@ -68,10 +68,13 @@ Action and_or_action(const State& state) {
 }
 
 int main() {
-    std::array<play::Player<State, Action>, 2> players = {
-        [](const State& state) { return and_or_action(state); },
-        [](const State& state) { return random_action(state); },
-    };
-    play::test_ai(players, 10000);
+    // ゲームをスレッドに分配して並列に対戦する. ランダムプレイヤーの乱数はゲームごとの種から作る
+    play::MatchOptions options;
+    options.game_number = 10000;
+    const auto result = play::run_match<State>(
+        [](uint64_t) { return [](const State& state) { return and_or_action(state); }; },
+        [](uint64_t seed) { return [engine = std::mt19937(seed)](const State& state) mutable { return random_action(state, engine); }; },
+        options);
+    play::print_match_result(result, options);
     return 0;
 }
\ No newline at end of file
@@ -2,18 +2,19 @@
 トランスポジションテーブルを利用し, AND/OR 木探索を効率化
 */
 
-#include <array>
 #include <random>
 
+#include "games/match_runner.hpp"
 #include "games/play.hpp"
 #include "games/tic_tac_toe.hpp"
+#include "utils/transposition_table.hpp"
 
 using State = tic_tac_toe::State;
 using Action = tic_tac_toe::Action;
 using tic_tac_toe::random_action;
 
-using tic_tac_toe::zobrist_hashing::HashValue;
-std::unordered_map<HashValue, int> state_values;
+// 並列に対戦するので, スレッドごとに表を持つ
+thread_local TranspositionTable<int> state_values(1);
 
 int or_score(const State& state);
 int and_score(const State& state);
@@ -32,8 +33,8 @@ int and_score(const State& state) {
         for (const auto action : legal_actions) {
             State next_state = state;
             next_state.step(action);
-            if (state_values.contains(next_state.hash_value)) {
-                state_value &= state_values[next_state.hash_value];
+            if (const auto* value = state_values.find(next_state.hash_value); value != nullptr) {
+                state_value &= *value;
             } else {
                 state_value &= or_score(next_state);
             }
@@ -43,7 +44,7 @@ int and_score(const State& state) {
         }
         break;
     }
-    state_values[state.hash_value] = state_value;
+    state_values.store(state.hash_value, state_value);
     return state_value;
 }
 
@@ -61,8 +62,8 @@ int or_score(const State& state) {
         for (const auto action : legal_actions) {
             State next_state = state;
             next_state.step(action);
-            if (state_values.contains(next_state.hash_value)) {
-                state_value |= state_values[next_state.hash_value];
+            if (const auto* value = state_values.find(next_state.hash_value); value != nullptr) {
+                state_value |= *value;
             } else {
                 state_value |= and_score(next_state);
             }
@@ -72,7 +73,7 @@ int or_score(const State& state) {
         }
         break;
     }
-    state_values[state.hash_value] = state_value;
+    state_values.store(state.hash_value, state_value);
     return state_value;
 }
 
@@ -90,10 +91,13 @@ Action and_or_action(const State& state) {
 }
 
 int main() {
-    std::array<play::Player<State, Action>, 2> players = {
-        [](const State& state) { return and_or_action(state); },
-        [](const State& state) { return random_action(state); },
-    };
-    play::test_ai(players, 10000);
+    // ゲームをスレッドに分配して並列に対戦する. ランダムプレイヤーの乱数はゲームごとの種から作る
+    play::MatchOptions options;
+    options.game_number = 10000;
+    const auto result = play::run_match<State>(
+        [](uint64_t) { return [](const State& state) { return and_or_action(state); }; },
+        [](uint64_t seed) { return [engine = std::mt19937(seed)](const State& state) mutable { return random_action(state, engine); }; },
+        options);
+    play::print_match_result(result, options);
     return 0;
 }
\ No newline at end of file
@@ -1,77 +1,44 @@
 /*
 A* 探索
+節点は utils/a_star のプールに確保し, open リストは f コストのバケットキュー, closed リストは 1 つのハッシュ表で管理する
+同じ初期配置を, h コストの方針 (マンハッタン距離, linear conflict, walking distance) を変えて解き比べる
 */
 
-#include <algorithm>
-#include <functional>
+#include <array>
+#include <chrono>
 #include <iostream>
-#include <memory>
-#include <queue>
-#include <unordered_set>
-#include <unordered_map>
+#include <string>
 #include <vector>
 
 #include "games/fifteen_puzzle.hpp"
+#include "utils/a_star.hpp"
+#include "utils/memory_usage.hpp"
 
 using State = fifteen_puzzle::State;
-using StatePtr = fifteen_puzzle::StatePtr;
 using Action = fifteen_puzzle::Action;
 
-using fifteen_puzzle::zobrist_hashing::HashValue;
-
-std::vector<State> get_shortest_path(StatePtr state) {
-    std::vector<State> shortest_path;
-    while (state->pre_state_ptr != nullptr) {
-        shortest_path.emplace_back(*state);
-        state = state->pre_state_ptr;
-    }
-    shortest_path.emplace_back(*state);
-    std::reverse(shortest_path.begin(), shortest_path.end());
-    return shortest_path;
-}
-
-std::vector<State> explore() {
-    auto initial_state = std::make_shared<State>();
-    auto frontier = std::priority_queue<StatePtr, std::vector<StatePtr>, std::function<bool(const StatePtr, const StatePtr)>>(fifteen_puzzle::compare_f_cost);
-    frontier.emplace(initial_state);
-    std::unordered_map<HashValue, int> state_cost;
-    std::unordered_set<HashValue> explored;
-    state_cost[initial_state->hash_value] = initial_state->get_f_cost();
-    std::vector<State> shortest_path;
-    while (!frontier.empty()) {
-        auto state = frontier.top();
-        if (state->is_done()) {
-            shortest_path = get_shortest_path(state);
-            break;
-        }
-        frontier.pop();
-        if (state->get_f_cost() != state_cost[state->hash_value]) {
-            continue;
-        }
-        explored.emplace(state->hash_value);
-        auto legal_actions = state->legal_actions();
-        for (const auto action : legal_actions) {
-            StatePtr next_state = std::make_shared<State>(*state);
-            next_state->step(action);
-            if (explored.contains(next_state->hash_value)) {
-                continue;
-            }
-            if (state_cost.contains(next_state->hash_value) && state_cost[next_state->hash_value] < next_state->get_f_cost()) {
-                continue;
-            }
-            next_state->pre_state_ptr = state;
-            frontier.emplace(next_state);
-            state_cost[next_state->hash_value] = next_state->get_f_cost();
-        }
-    }
+template <template <class> class Heuristic>
+std::vector<fifteen_puzzle::BasicFifteenPuzzleState<Heuristic>> explore(const std::string& name, const std::array<int, 16>& board) {
+    using HeuristicState = fifteen_puzzle::BasicFifteenPuzzleState<Heuristic>;
+    const HeuristicState initial_state(board);
+    a_star::Solver<HeuristicState> solver;
+    const auto start_time = std::chrono::high_resolution_clock::now();
+    auto shortest_path = solver.solve(initial_state);
+    const double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+    std::cout << name << '\t' << initial_state.h_cost << '\t' << shortest_path.size() << '\t' << solver.expanded_count() << '\t' << seconds << '\t'
+              << solver.expanded_count() / seconds << '\t' << static_cast<double>(solver.size_in_bytes()) / solver.node_count() << std::endl;
     return shortest_path;
 }
 
 int main() {
-    auto shortest_path = explore();
-    std::cout << "shortest path length\t" << shortest_path.size() << std::endl;
+    const auto board = fifteen_puzzle::random_walk_board();
+    std::cout << "heuristic\tinitial h\tshortest path length\texpanded\ttime [s]\texpansions/sec\tbytes/node" << std::endl;
+    auto shortest_path = explore<fifteen_puzzle::heuristic::Manhattan>("manhattan", board);
+    explore<fifteen_puzzle::heuristic::LinearConflict>("linear_conflict", board);
+    explore<fifteen_puzzle::heuristic::WalkingDistance>("walking_distance", board);
+    std::cout << "peak RSS [KB]\t" << memory_usage::peak_rss_kb() << std::endl;
     for (const auto& state : shortest_path) {
         std::cout << state << std::endl;
     }
     return 0;
-}
\ No newline at end of file
+}
@@ -1,95 +1,50 @@
 /*
 反復深化 A* 探索
-std::shared_ptr は explore_with_threshold を抜けるたびにメモリを解放する
+utils/ida_star で, 1 つの状態を step / undo で書き換えながら深さ優先に探索する
+同じ初期配置を, h コストの方針 (マンハッタン距離, linear conflict, walking distance) を変えて解き比べる
 */
 
-#include <algorithm>
-#include <functional>
+#include <array>
+#include <chrono>
 #include <iostream>
-#include <memory>
-#include <queue>
-#include <unordered_set>
-#include <unordered_map>
-#include <utility>
+#include <string>
 #include <vector>
 
 #include "games/fifteen_puzzle.hpp"
+#include "utils/ida_star.hpp"
 
 using State = fifteen_puzzle::State;
-using StatePtr = fifteen_puzzle::StatePtr;
 using Action = fifteen_puzzle::Action;
 
-using fifteen_puzzle::zobrist_hashing::HashValue;
-
-std::vector<State> get_shortest_path(StatePtr state) {
-    std::vector<State> shortest_path;
-    while (state->pre_state_ptr != nullptr) {
-        shortest_path.emplace_back(*state);
-        state = state->pre_state_ptr;
-    }
-    shortest_path.emplace_back(*state);
-    std::reverse(shortest_path.begin(), shortest_path.end());
-    return shortest_path;
-}
-
-std::pair<bool, std::vector<State>> explore_with_threshold(int threshold) {
-    auto initial_state = std::make_shared<State>();
-    auto frontier = std::priority_queue<StatePtr, std::vector<StatePtr>, std::function<bool(const StatePtr, const StatePtr)>>(fifteen_puzzle::compare_f_cost);
-    frontier.emplace(initial_state);
-    std::unordered_map<HashValue, int> state_cost;
-    std::unordered_set<HashValue> explored;
-    state_cost[initial_state->hash_value] = initial_state->get_f_cost();
-    std::vector<State> shortest_path;
-    bool is_solved = false;
-    while (!frontier.empty()) {
-        auto state = frontier.top();
-        if (state->is_done()) {
-            std::cout << threshold << std::endl;
-            shortest_path = get_shortest_path(state);
-            is_solved = true;
-            break;
-        }
-        frontier.pop();
-        if (state->get_f_cost() != state_cost[state->hash_value]) {
-            continue;
-        }
-        explored.emplace(state->hash_value);
-        auto legal_actions = state->legal_actions();
-        for (const auto action : legal_actions) {
-            StatePtr next_state = std::make_shared<State>(*state);
-            next_state->step(action);
-            if (explored.contains(next_state->hash_value)) {
-                continue;
-            }
-            int next_f_cost = next_state->get_f_cost();
-            if (next_f_cost > threshold) {
-                return {false, std::vector<State>()};
-            }
-            if (state_cost.contains(next_state->hash_value) && state_cost[next_state->hash_value] < next_f_cost) {
-                continue;
-            }
-            next_state->pre_state_ptr = state;
-            frontier.emplace(next_state);
-            state_cost[next_state->hash_value] = next_f_cost;
-        }
-    }
-    return {is_solved, shortest_path};
-}
-
-std::vector<State> explore() {
-    for (int threshold = 1; ; ++threshold) {
-        const auto [is_solved, shortest_path] = explore_with_threshold(threshold);
-        if (is_solved) {
-            return shortest_path;
-        }
+template <template <class> class Heuristic>
+std::vector<Action> explore(const std::string& name, const std::array<int, 16>& board) {
+    using HeuristicState = fifteen_puzzle::BasicFifteenPuzzleState<Heuristic>;
+    const HeuristicState initial_state(board);
+    ida_star::Solver<HeuristicState> solver;
+    const auto start_time = std::chrono::high_resolution_clock::now();
+    const auto actions = solver.solve(initial_state);
+    const double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+    std::cout << name << std::endl;
+    std::cout << "threshold\tnodes\ttime [s]\tnodes/sec" << std::endl;
+    for (const auto& iteration : solver.iterations()) {
+        std::cout << iteration.threshold << '\t' << iteration.node_count << '\t' << iteration.seconds << '\t' << iteration.node_count / iteration.seconds << std::endl;
     }
+    std::cout << "shortest path length\t" << actions.size() + 1 << std::endl;
+    std::cout << "nodes\t" << solver.total_node_count() << "\ttime [s]\t" << seconds << "\tnodes/sec\t" << solver.total_node_count() / seconds << std::endl;
+    std::cout << std::endl;
+    return actions;
 }
 
 int main() {
-    auto shortest_path = explore();
-    std::cout << "shortest path length\t" << shortest_path.size() << std::endl;
-    for (const auto& state : shortest_path) {
+    const auto board = fifteen_puzzle::random_walk_board();
+    State state(board);
+    const auto actions = explore<fifteen_puzzle::heuristic::Manhattan>("manhattan", board);
+    explore<fifteen_puzzle::heuristic::LinearConflict>("linear_conflict", board);
+    explore<fifteen_puzzle::heuristic::WalkingDistance>("walking_distance", board);
+    std::cout << state << std::endl;
+    for (const auto action : actions) {
+        state.step(action);
         std::cout << state << std::endl;
     }
     return 0;
-}
\ No newline at end of file
+}
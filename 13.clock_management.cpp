@@ -0,0 +1,203 @@
+/*
+持ち時間管理
+1 局の持ち時間が同じ条件で, 毎手固定の時間を使うプレイヤーと ClockManager で配分するプレイヤーを対戦させる
+探索は 03.iterative_deeping と同じ反復深化アルファベータ探索で,
+ハードリミットで探索を打ち切り, ソフトリミットで次の反復を始めるかを決める
+*/
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <string>
+
+#include "games/play.hpp"
+#include "games/othello.hpp"
+#include "utils/clock_manager.hpp"
+#include "utils/time_keeper.hpp"
+
+using State = othello::State;
+using Action = othello::Action;
+
+using othello::score::ScoreType;
+using othello::score::INF;
+
+struct SearchResult {
+    Action best_action = othello::NO_POS;
+    ScoreType best_score = -INF;
+    bool is_completed = false;
+};
+
+ScoreType alphabeta_score(const State& state, ScoreType alpha, const ScoreType beta, const int depth, const TimeKeeper& time_keeper) {
+    if (time_keeper.is_time_over()) {
+        return 0;
+    }
+    if (state.is_done() || depth == 0) {
+        return state.get_score();
+    }
+    auto legal_actions = state.legal_actions();
+    if (legal_actions.empty()) {
+        legal_actions.emplace_back(othello::NO_POS);
+    }
+    for (const auto action : legal_actions) {
+        State next_state = state;
+        next_state.step(action);
+        ScoreType score = -alphabeta_score(next_state, -beta, -alpha, depth - 1, time_keeper);
+        if (score > alpha) {
+            alpha = score;
+        }
+        if (alpha >= beta) {
+            return alpha;
+        }
+        if (time_keeper.is_time_over()) {
+            return 0;
+        }
+    }
+    return alpha;
+}
+
+SearchResult alphabeta_action_with_time_threshold(const State& state, const int depth, const Action first_action, const TimeKeeper& time_keeper) {
+    SearchResult result;
+    ScoreType alpha = -INF;
+    ScoreType beta = INF;
+    auto legal_actions = state.legal_actions();
+    if (auto it = std::find(legal_actions.begin(), legal_actions.end(), first_action); it != legal_actions.end()) {
+        std::rotate(legal_actions.begin(), it, it + 1);
+    }
+    for (const auto action : legal_actions) {
+        State next_state = state;
+        next_state.step(action);
+        ScoreType score = -alphabeta_score(next_state, -beta, -alpha, depth, time_keeper);
+        if (time_keeper.is_time_over()) {
+            return result;
+        }
+        if (score > alpha) {
+            result.best_action = action;
+            result.best_score = score;
+            alpha = score;
+        }
+    }
+    result.is_completed = true;
+    return result;
+}
+
+// clock_manager が nullptr でなければ, 反復ごとに最善手の変化と評価値の変化を伝えてソフトリミットを調整させる
+Action iterative_deeping_action(const State& state, TimeKeeper& time_keeper, ClockManager* clock_manager) {
+    Action best_action = othello::NO_POS;
+    ScoreType best_score = 0;
+    int64_t pre_iteration_time = 0;
+    int64_t last_iteration_time = 0;
+    for (int depth = 1; ; ++depth) {
+        if (time_keeper.is_soft_time_over()) {
+            break;
+        }
+        if (pre_iteration_time > 0) {
+            const double branching_factor = std::max(1.0, static_cast<double>(last_iteration_time) / pre_iteration_time);
+            if (last_iteration_time * branching_factor > time_keeper.soft_remaining_microseconds()) {
+                break;
+            }
+        }
+
+        const int64_t iteration_start_time = time_keeper.elapsed_microseconds();
+        const auto result = alphabeta_action_with_time_threshold(state, depth, best_action, time_keeper);
+        if (!result.is_completed) {
+            if (result.best_action != othello::NO_POS) {
+                best_action = result.best_action;
+            }
+            break;
+        }
+        if (clock_manager != nullptr && depth > 1) {
+            clock_manager->update_iteration(time_keeper, result.best_action != best_action, result.best_score - best_score);
+        }
+        best_action = result.best_action;
+        best_score = result.best_score;
+        if (depth >= state.count_empties()) {
+            break;
+        }
+        pre_iteration_time = last_iteration_time;
+        last_iteration_time = time_keeper.elapsed_microseconds() - iteration_start_time;
+    }
+    return best_action;
+}
+
+// 対局ごとの持ち時間の記録を対戦全体で集計する
+struct ClockSummary {
+    int game_count = 0;
+    // 持ち時間を使い切った局数と回数
+    int time_over_game_count = 0;
+    int time_over_count = 0;
+    // 使った時間と終局時の残り時間の合計 (マイクロ秒)
+    int64_t used_time = 0;
+    int64_t remaining_time = 0;
+    bool is_playing = false;
+
+    // 対局が終わったときに呼ぶ
+    void finish_game(const ClockManager& clock) {
+        if (!is_playing) {
+            return;
+        }
+        ++game_count;
+        time_over_game_count += clock.time_over_count() > 0;
+        time_over_count += clock.time_over_count();
+        remaining_time += clock.remaining_time();
+        is_playing = false;
+    }
+};
+
+void print_clock_summary(const std::string& name, const ClockSummary& summary) {
+    const double game_count = std::max(summary.game_count, 1);
+    std::cout << name << "	" << summary.game_count << "	" << summary.used_time / 1000.0 / game_count << "	"
+              << summary.remaining_time / 1000.0 / game_count << "	" << summary.time_over_game_count << "	" << summary.time_over_count << std::endl;
+}
+
+// 自分が終局までに打つ手数の見積もり
+int remaining_moves(const State& state) {
+    return (state.count_empties() + 1) / 2;
+}
+
+int main() {
+    // 1 局あたりの持ち時間 (ミリ秒)
+    static constexpr int64_t TOTAL_TIME = 200;
+    // 固定配分のプレイヤーは, 自分の最大手数程度で持ち時間を等分する
+    static constexpr int64_t FIXED_TIME = TOTAL_TIME / 32;
+
+    // 手番 0, 1 で新しい対局の始まりを検知して持ち時間をリセットする
+    // 固定配分のプレイヤーは配分に使わないが, 同じ持ち時間で時間切れになっていないかを確かめるために記録する
+    ClockManager managed_clock(TOTAL_TIME);
+    ClockManager fixed_clock(TOTAL_TIME);
+    ClockSummary managed_summary;
+    ClockSummary fixed_summary;
+    std::array<play::Player<State, Action>, 2> players = {
+        [&managed_clock, &managed_summary](const State& state) {
+            if (state.turn < 2) {
+                managed_summary.finish_game(managed_clock);
+                managed_clock.start_game();
+                managed_summary.is_playing = true;
+            }
+            auto time_keeper = managed_clock.start_move(remaining_moves(state));
+            const auto action = iterative_deeping_action(state, time_keeper, &managed_clock);
+            managed_clock.finish_move(time_keeper);
+            managed_summary.used_time += time_keeper.elapsed_microseconds();
+            return action;
+        },
+        [&fixed_clock, &fixed_summary](const State& state) {
+            if (state.turn < 2) {
+                fixed_summary.finish_game(fixed_clock);
+                fixed_clock.start_game();
+                fixed_summary.is_playing = true;
+            }
+            auto time_keeper = TimeKeeper(FIXED_TIME);
+            const auto action = iterative_deeping_action(state, time_keeper, nullptr);
+            fixed_clock.finish_move(time_keeper);
+            fixed_summary.used_time += time_keeper.elapsed_microseconds();
+            return action;
+        },
+    };
+    play::test_ai(players, 100);
+    managed_summary.finish_game(managed_clock);
+    fixed_summary.finish_game(fixed_clock);
+
+    std::cout << "player	games	used [ms/game]	remaining [ms/game]	time over games	time over moves" << std::endl;
+    print_clock_summary("managed", managed_summary);
+    print_clock_summary("fixed", fixed_summary);
+    return 0;
+}
@@ -0,0 +1,110 @@
+/*
+ProbCut のパラメータ調整
+ランダムに進めた局面で浅い探索と深い探索の評価値を集め, (ステージ, 深さの組) ごとに線形回帰した結果をファイルに書き出す
+15.multi_probcut はこのファイルを読み込んで枝刈りする
+使い方: probcut_calibration [サンプル局面数] [出力ファイル] [乱数シード]
+*/
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "games/othello.hpp"
+#include "utils/probcut.hpp"
+
+using State = othello::State;
+using Action = othello::Action;
+
+using othello::score::ScoreType;
+using othello::score::INF;
+
+// (浅い探索の深さ, 深い探索の深さ) の組
+static constexpr std::pair<int, int> DEPTH_PAIRS[] = {
+    {1, 3}, {2, 4}, {1, 5}, {3, 5}, {2, 6}, {4, 6},
+};
+static constexpr int MAX_SAMPLE_DEPTH = 6;
+
+ScoreType alpha_beta_score(const State& state, ScoreType alpha, const ScoreType beta, const int depth) {
+    if (state.is_done() || depth == 0) {
+        return state.get_score2();
+    }
+    auto legal_actions = state.legal_actions();
+    if (legal_actions.empty()) {
+        legal_actions.emplace_back(othello::NO_POS);
+    }
+    for (const auto action : legal_actions) {
+        State next_state = state;
+        next_state.step(action);
+        ScoreType score = -alpha_beta_score(next_state, -beta, -alpha, depth - 1);
+        if (score > alpha) {
+            alpha = score;
+        }
+        if (alpha >= beta) {
+            return alpha;
+        }
+    }
+    return alpha;
+}
+
+// 初期局面からランダムに手を進めて, 終局していない局面を作る
+State sample_state(std::mt19937& engine) {
+    while (true) {
+        State state;
+        const int turn = 2 + engine() % 52;
+        for (int t = 0; t < turn && !state.is_done(); ++t) {
+            const auto legal_actions = state.legal_actions();
+            state.step(legal_actions.empty() ? othello::NO_POS : legal_actions[engine() % legal_actions.size()]);
+        }
+        if (!state.is_done()) {
+            return state;
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const int sample_count = argc > 1 ? std::stoi(argv[1]) : 300;
+    const std::string path = argc > 2 ? argv[2] : "data/probcut.txt";
+    std::mt19937 engine(argc > 3 ? std::stoul(argv[3]) : 0);
+
+    // samples[stage][pair_idx] に (浅い探索の評価値, 深い探索の評価値) を溜める
+    constexpr int PAIR_COUNT = std::size(DEPTH_PAIRS);
+    std::vector<std::pair<double, double>> samples[probcut::STAGE_COUNT][PAIR_COUNT];
+    for (int t = 0; t < sample_count; ++t) {
+        const State state = sample_state(engine);
+        ScoreType scores[MAX_SAMPLE_DEPTH + 1];
+        for (int depth = 1; depth <= MAX_SAMPLE_DEPTH; ++depth) {
+            scores[depth] = alpha_beta_score(state, -INF, INF, depth);
+        }
+        const int stage = probcut::get_stage(state.count_empties());
+        for (int pair_idx = 0; pair_idx < PAIR_COUNT; ++pair_idx) {
+            const auto [shallow_depth, deep_depth] = DEPTH_PAIRS[pair_idx];
+            samples[stage][pair_idx].emplace_back(scores[shallow_depth], scores[deep_depth]);
+        }
+        if ((t + 1) % 100 == 0) {
+            std::cerr << "sampled\t" << t + 1 << std::endl;
+        }
+    }
+
+    probcut::ParameterTable table;
+    std::cout << "stage\tshallow\tdeep\ta\tb\tsigma\tsamples" << std::endl;
+    for (int stage = 0; stage < probcut::STAGE_COUNT; ++stage) {
+        for (int pair_idx = 0; pair_idx < PAIR_COUNT; ++pair_idx) {
+            const auto [shallow_depth, deep_depth] = DEPTH_PAIRS[pair_idx];
+            const auto& stage_samples = samples[stage][pair_idx];
+            if (stage_samples.size() < 2) {
+                continue;
+            }
+            const auto parameter = probcut::fit(stage, shallow_depth, deep_depth, stage_samples);
+            table.add(parameter);
+            std::cout << stage << '\t' << shallow_depth << '\t' << deep_depth << '\t' << parameter.a << '\t' << parameter.b << '\t' << parameter.sigma << '\t' << stage_samples.size() << std::endl;
+        }
+    }
+    if (!table.save(path)) {
+        std::cerr << "Error: cannot write " << path << std::endl;
+        return 1;
+    }
+    std::cout << "saved\t" << path << std::endl;
+    return 0;
+}
@@ -0,0 +1,176 @@
+/*
+Multi-ProbCut
+浅い探索の評価値から深い探索の評価値を線形予測し, 予測値が探索窓の外にある確率が高ければ深い探索を省略する
+パラメータは 14.probcut_calibration が書き出した data/probcut.txt から読み込む
+*/
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+#include "games/play.hpp"
+#include "games/othello.hpp"
+#include "utils/probcut.hpp"
+#include "utils/time_keeper.hpp"
+
+using State = othello::State;
+using Action = othello::Action;
+
+using othello::score::ScoreType;
+using othello::score::INF;
+
+// 予測値が窓から CUT_THRESHOLD * sigma 以上外れていれば枝刈りする
+static constexpr double CUT_THRESHOLD = 2.0;
+// 決定的なプレイヤー同士の対戦が毎回同じ棋譜にならないよう, 序盤はランダムに打つ
+static constexpr unsigned int RANDOM_OPENING_TURNS = 4;
+
+static probcut::ParameterTable parameter_table;
+static int64_t node_count = 0;
+
+struct SearchResult {
+    Action best_action = othello::NO_POS;
+    ScoreType best_score = -INF;
+    bool is_completed = false;
+};
+
+ScoreType alphabeta_score(const State& state, ScoreType alpha, const ScoreType beta, const int depth, const TimeKeeper& time_keeper, const bool use_probcut) {
+    ++node_count;
+    if (time_keeper.is_time_over()) {
+        return 0;
+    }
+    if (state.is_done() || depth == 0) {
+        return state.get_score2();
+    }
+    // 窓が無限でなければ, 浅い探索の組を浅い順に試す
+    if (use_probcut && -INF < alpha && beta < INF) {
+        const int stage = probcut::get_stage(state.count_empties());
+        for (const auto& parameter : parameter_table.find(stage, depth)) {
+            if (parameter.a <= 0) {
+                continue;
+            }
+            const double margin = CUT_THRESHOLD * parameter.sigma;
+            const auto high_bound = static_cast<ScoreType>(std::ceil((beta + margin - parameter.b) / parameter.a));
+            if (alphabeta_score(state, high_bound - 1, high_bound, parameter.shallow_depth, time_keeper, use_probcut) >= high_bound) {
+                return beta;
+            }
+            const auto low_bound = static_cast<ScoreType>(std::floor((alpha - margin - parameter.b) / parameter.a));
+            if (alphabeta_score(state, low_bound, low_bound + 1, parameter.shallow_depth, time_keeper, use_probcut) <= low_bound) {
+                return alpha;
+            }
+        }
+    }
+    auto legal_actions = state.legal_actions();
+    if (legal_actions.empty()) {
+        legal_actions.emplace_back(othello::NO_POS);
+    }
+    for (const auto action : legal_actions) {
+        State next_state = state;
+        next_state.step(action);
+        ScoreType score = -alphabeta_score(next_state, -beta, -alpha, depth - 1, time_keeper, use_probcut);
+        if (score > alpha) {
+            alpha = score;
+        }
+        if (alpha >= beta) {
+            return alpha;
+        }
+        if (time_keeper.is_time_over()) {
+            return 0;
+        }
+    }
+    return alpha;
+}
+
+SearchResult alphabeta_action(const State& state, const int depth, const Action first_action, const TimeKeeper& time_keeper, const bool use_probcut) {
+    SearchResult result;
+    ScoreType alpha = -INF;
+    ScoreType beta = INF;
+    auto legal_actions = state.legal_actions();
+    if (auto it = std::find(legal_actions.begin(), legal_actions.end(), first_action); it != legal_actions.end()) {
+        std::rotate(legal_actions.begin(), it, it + 1);
+    }
+    for (const auto action : legal_actions) {
+        State next_state = state;
+        next_state.step(action);
+        ScoreType score = -alphabeta_score(next_state, -beta, -alpha, depth, time_keeper, use_probcut);
+        if (time_keeper.is_time_over()) {
+            return result;
+        }
+        if (score > alpha) {
+            result.best_action = action;
+            result.best_score = score;
+            alpha = score;
+        }
+    }
+    result.is_completed = true;
+    return result;
+}
+
+Action iterative_deeping_action(const State& state, const int64_t time_threshold, const bool use_probcut) {
+    if (state.turn < RANDOM_OPENING_TURNS) {
+        return othello::random_action(state);
+    }
+    auto time_keeper = TimeKeeper(time_threshold);
+    Action best_action = othello::NO_POS;
+    for (int depth = 1; ; ++depth) {
+        const auto result = alphabeta_action(state, depth, best_action, time_keeper, use_probcut);
+        if (result.best_action != othello::NO_POS) {
+            best_action = result.best_action;
+        }
+        if (!result.is_completed || depth >= state.count_empties()) {
+            break;
+        }
+    }
+    return best_action;
+}
+
+// 固定深さで探索したときのノード数を比較する
+void compare_node_count(const int position_count) {
+    std::mt19937 engine(0);
+    std::vector<State> states;
+    while (static_cast<int>(states.size()) < position_count) {
+        State state;
+        const int turn = 10 + engine() % 30;
+        for (int t = 0; t < turn && !state.is_done(); ++t) {
+            const auto legal_actions = state.legal_actions();
+            state.step(legal_actions.empty() ? othello::NO_POS : legal_actions[engine() % legal_actions.size()]);
+        }
+        if (!state.is_done()) {
+            states.emplace_back(state);
+        }
+    }
+
+    const auto time_keeper = TimeKeeper(INT32_MAX);
+    std::cout << "depth\tnodes (alpha-beta)\tnodes (probcut)\tratio\tsame action" << std::endl;
+    for (int depth = 3; depth <= 7; ++depth) {
+        int64_t node_counts[2] = {};
+        int same_action_count = 0;
+        for (const auto& state : states) {
+            Action actions[2];
+            for (int use_probcut = 0; use_probcut < 2; ++use_probcut) {
+                node_count = 0;
+                actions[use_probcut] = alphabeta_action(state, depth, othello::NO_POS, time_keeper, use_probcut).best_action;
+                node_counts[use_probcut] += node_count;
+            }
+            same_action_count += actions[0] == actions[1];
+        }
+        std::cout << depth + 1 << '\t' << node_counts[0] << '\t' << node_counts[1] << '\t' << static_cast<double>(node_counts[1]) / node_counts[0] << '\t' << same_action_count << '/' << position_count << std::endl;
+    }
+}
+
+int main() {
+    if (!parameter_table.load("data/probcut.txt") || parameter_table.empty()) {
+        std::cerr << "Error: cannot load data/probcut.txt. Run probcut_calibration first." << std::endl;
+        return 1;
+    }
+    compare_node_count(30);
+
+    // 同じ持ち時間で ProbCut あり / なしを対戦させる
+    std::array<play::Player<State, Action>, 2> players = {
+        [](const State& state) { return iterative_deeping_action(state, 10, true); },
+        [](const State& state) { return iterative_deeping_action(state, 10, false); },
+    };
+    play::test_ai(players, 100);
+    return 0;
+}
@@ -0,0 +1,197 @@
+/*
+完全解析表による三目並べ
+コンパイル時に作った表を引くだけで最善手を返すプレイヤーと, 09.and_or, 10.transposition_table の AND/OR 木探索のプレイヤーで
+1 秒あたりの着手決定数を比較する
+*/
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "games/play.hpp"
+#include "games/tic_tac_toe.hpp"
+#include "games/tic_tac_toe_table.hpp"
+#include "utils/transposition_table.hpp"
+
+using State = tic_tac_toe::State;
+using Action = tic_tac_toe::Action;
+using tic_tac_toe::random_action;
+
+// 09.and_or と同じ AND/OR 木探索
+namespace and_or {
+
+int or_score(const State& state);
+
+int and_score(const State& state) {
+    switch (state.get_winning_status()) {
+    case WinningStatus::LOSE:
+        return 1;
+    case WinningStatus::WIN:
+    case WinningStatus::DRAW:
+        return 0;
+    default:
+        for (const auto action : state.legal_actions()) {
+            State next_state = state;
+            next_state.step(action);
+            if (!or_score(next_state)) {
+                return 0;
+            }
+        }
+        return 1;
+    }
+}
+
+int or_score(const State& state) {
+    switch (state.get_winning_status()) {
+    case WinningStatus::WIN:
+        return 1;
+    case WinningStatus::LOSE:
+    case WinningStatus::DRAW:
+        return 0;
+    default:
+        for (const auto action : state.legal_actions()) {
+            State next_state = state;
+            next_state.step(action);
+            if (and_score(next_state)) {
+                return 1;
+            }
+        }
+        return 0;
+    }
+}
+
+Action and_or_action(const State& state) {
+    auto legal_actions = state.legal_actions();
+    for (const auto action : legal_actions) {
+        State next_state = state;
+        next_state.step(action);
+        if (and_score(next_state)) {
+            return action;
+        }
+    }
+    return legal_actions[0];
+}
+
+} // namespace and_or
+
+// 10.transposition_table と同じ, トランスポジションテーブル付きの AND/OR 木探索
+namespace transposition_table {
+
+TranspositionTable<int> state_values(1);
+
+int or_score(const State& state);
+
+int and_score(const State& state) {
+    int state_value = 1;
+    switch (state.get_winning_status()) {
+    case WinningStatus::LOSE:
+        break;
+    case WinningStatus::WIN:
+    case WinningStatus::DRAW:
+        state_value = 0;
+        break;
+    default:
+        for (const auto action : state.legal_actions()) {
+            State next_state = state;
+            next_state.step(action);
+            if (const auto* value = state_values.find(next_state.hash_value); value != nullptr) {
+                state_value &= *value;
+            } else {
+                state_value &= or_score(next_state);
+            }
+            if (!state_value) {
+                break;
+            }
+        }
+        break;
+    }
+    state_values.store(state.hash_value, state_value);
+    return state_value;
+}
+
+int or_score(const State& state) {
+    int state_value = 0;
+    switch (state.get_winning_status()) {
+    case WinningStatus::WIN:
+        state_value = 1;
+        break;
+    case WinningStatus::LOSE:
+    case WinningStatus::DRAW:
+        break;
+    default:
+        for (const auto action : state.legal_actions()) {
+            State next_state = state;
+            next_state.step(action);
+            if (const auto* value = state_values.find(next_state.hash_value); value != nullptr) {
+                state_value |= *value;
+            } else {
+                state_value |= and_score(next_state);
+            }
+            if (state_value) {
+                break;
+            }
+        }
+        break;
+    }
+    state_values.store(state.hash_value, state_value);
+    return state_value;
+}
+
+Action and_or_action(const State& state) {
+    state_values.clear();
+    auto legal_actions = state.legal_actions();
+    for (const auto action : legal_actions) {
+        State next_state = state;
+        next_state.step(action);
+        if (and_score(next_state)) {
+            return action;
+        }
+    }
+    return legal_actions[0];
+}
+
+} // namespace transposition_table
+
+// ランダム対局に現れる非終端局面を集める
+std::vector<State> sample_states(const int game_number) {
+    std::vector<State> states;
+    for (int t = 0; t < game_number; ++t) {
+        State state;
+        while (!state.is_done()) {
+            states.emplace_back(state);
+            state.step(random_action(state));
+        }
+    }
+    return states;
+}
+
+template <class Function>
+void benchmark(const std::string& name, const std::vector<State>& states, Function action_function) {
+    const auto start_time = std::chrono::high_resolution_clock::now();
+    // 最適化で呼び出しが消えないよう, 結果を足し合わせる
+    unsigned int checksum = 0;
+    for (const auto& state : states) {
+        checksum += action_function(state);
+    }
+    const auto diff = std::chrono::high_resolution_clock::now() - start_time;
+    const double seconds = std::chrono::duration<double>(diff).count();
+    std::cout << name << "\t" << states.size() / seconds << "\t(checksum " << checksum << ")" << std::endl;
+}
+
+int main() {
+    const auto states = sample_states(1000);
+    std::cout << "player\tdecisions/sec" << std::endl;
+    benchmark("and_or", states, and_or::and_or_action);
+    benchmark("transposition_table", states, transposition_table::and_or_action);
+    benchmark("perfect_play_table", states, tic_tac_toe::perfect_play::best_action);
+
+    std::array<play::Player<State, Action>, 2> players = {
+        [](const State& state) { return tic_tac_toe::perfect_play::best_action(state); },
+        [](const State& state) { return random_action(state); },
+    };
+    play::test_ai(players, 10000);
+    return 0;
+}
@@ -0,0 +1,82 @@
+/*
+トランスポジションテーブルの性能比較
+std::unordered_map と TranspositionTable に同じ乱数キーを書き込み, 読み出したときの 1 秒あたりの操作回数と常駐メモリの増加量を比較する
+*/
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "utils/memory_usage.hpp"
+#include "utils/transposition_table.hpp"
+#include "utils/zobrist_hashing.hpp"
+
+using zobrist_hashing::HashValue;
+
+static constexpr int KEY_COUNT = 4000000;
+static constexpr std::size_t TABLE_SIZE_MB = 128;
+
+struct Entry {
+    int value;
+    int depth;
+};
+
+std::vector<HashValue> make_keys(HashValue seed) {
+    std::vector<HashValue> keys(KEY_COUNT);
+    for (auto& key : keys) {
+        key = zobrist_hashing::splitmix64(seed);
+    }
+    return keys;
+}
+
+double seconds_since(const std::chrono::high_resolution_clock::time_point start_time) {
+    return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+}
+
+void print_result(const std::string& name, const double store_seconds, const double probe_seconds, const int hit_count, const long rss_kb) {
+    std::cout << name << '\t' << KEY_COUNT / store_seconds << '\t' << 2 * KEY_COUNT / probe_seconds << '\t'
+              << static_cast<double>(hit_count) / KEY_COUNT << '\t' << rss_kb / 1024.0 << std::endl;
+}
+
+// table に keys を書き込み, keys (ヒット) と missing_keys (ミス) を読み出す
+template <class Table, class Store, class Probe>
+void benchmark(const std::string& name, Table& table, const std::vector<HashValue>& keys, const std::vector<HashValue>& missing_keys, const long base_rss_kb, Store store, Probe probe) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < KEY_COUNT; ++i) {
+        store(table, keys[i], Entry{i, 0});
+    }
+    const double store_seconds = seconds_since(start_time);
+    int hit_count = 0;
+    start_time = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < KEY_COUNT; ++i) {
+        hit_count += probe(table, keys[i]);
+        probe(table, missing_keys[i]);
+    }
+    const double probe_seconds = seconds_since(start_time);
+    print_result(name, store_seconds, probe_seconds, hit_count, memory_usage::current_rss_kb() - base_rss_kb);
+}
+
+int main() {
+    const auto keys = make_keys(1);
+    const auto missing_keys = make_keys(2);
+    std::cout << "table\tstores/sec\tprobes/sec\thit rate\tRSS [MB]" << std::endl;
+
+    // std::unordered_map が解放したメモリは OS に返らないことがあるので, 固定サイズの表から計測する
+    {
+        const long base_rss_kb = memory_usage::current_rss_kb();
+        TranspositionTable<Entry, replacement::DepthPreferred> table(TABLE_SIZE_MB);
+        benchmark("TranspositionTable", table, keys, missing_keys, base_rss_kb,
+            [](auto& table, const HashValue key, const Entry& entry) { table.store(key, entry); },
+            [](auto& table, const HashValue key) { return table.find(key) != nullptr; });
+    }
+    {
+        const long base_rss_kb = memory_usage::current_rss_kb();
+        std::unordered_map<HashValue, Entry> table;
+        benchmark("std::unordered_map", table, keys, missing_keys, base_rss_kb,
+            [](auto& table, const HashValue key, const Entry& entry) { table[key] = entry; },
+            [](auto& table, const HashValue key) { return table.find(key) != table.end(); });
+    }
+    return 0;
+}
@@ -0,0 +1,134 @@
+/*
+df-pn (depth-first proof-number search)
+三目並べの初期局面と, オセロの終盤局面の勝敗を df-pn で証明し, 09.and_or と同じ AND/OR 木探索と時間を比較する
+*/
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "games/othello.hpp"
+#include "games/play.hpp"
+#include "games/tic_tac_toe.hpp"
+#include "utils/df_pn.hpp"
+
+static constexpr std::size_t TABLE_SIZE_MB = 256;
+
+static int64_t node_count = 0;
+
+// 09.and_or と同じ AND/OR 木探索. 合法手が無ければパスする
+template <class State>
+bool or_score(const State& state, const bool is_draw_win);
+
+template <class State>
+bool and_score(const State& state, const bool is_draw_win) {
+    ++node_count;
+    switch (state.get_winning_status()) {
+    case WinningStatus::LOSE:
+        return true;
+    case WinningStatus::WIN:
+        return false;
+    case WinningStatus::DRAW:
+        return is_draw_win;
+    default:
+        auto legal_actions = state.legal_actions();
+        if (legal_actions.empty()) {
+            legal_actions.emplace_back();
+        }
+        for (const auto action : legal_actions) {
+            State next_state = state;
+            next_state.step(action);
+            if (!or_score(next_state, is_draw_win)) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+template <class State>
+bool or_score(const State& state, const bool is_draw_win) {
+    ++node_count;
+    switch (state.get_winning_status()) {
+    case WinningStatus::WIN:
+        return true;
+    case WinningStatus::LOSE:
+        return false;
+    case WinningStatus::DRAW:
+        return is_draw_win;
+    default:
+        auto legal_actions = state.legal_actions();
+        if (legal_actions.empty()) {
+            legal_actions.emplace_back();
+        }
+        for (const auto action : legal_actions) {
+            State next_state = state;
+            next_state.step(action);
+            if (and_score(next_state, is_draw_win)) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+double seconds_since(const std::chrono::high_resolution_clock::time_point start_time) {
+    return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+}
+
+std::string to_string(const df_pn::Result result) {
+    switch (result) {
+    case df_pn::Result::PROVEN:
+        return "proven";
+    case df_pn::Result::DISPROVEN:
+        return "disproven";
+    default:
+        return "unknown";
+    }
+}
+
+// 手番側の勝ち (is_draw_win なら負けないこと) を両方の方法で証明して比較する
+template <class State>
+void compare(const std::string& name, const State& state, const bool is_draw_win) {
+    df_pn::Solver<State> solver(TABLE_SIZE_MB, is_draw_win);
+    auto start_time = std::chrono::high_resolution_clock::now();
+    const auto result = solver.solve(state);
+    const double df_pn_seconds = seconds_since(start_time);
+
+    node_count = 0;
+    start_time = std::chrono::high_resolution_clock::now();
+    const bool and_or_result = or_score(state, is_draw_win);
+    const double and_or_seconds = seconds_since(start_time);
+
+    std::cout << name << '\t' << to_string(result) << '\t' << solver.node_count() << '\t' << df_pn_seconds << '\t'
+              << (and_or_result ? "proven" : "disproven") << '\t' << node_count << '\t' << and_or_seconds << std::endl;
+}
+
+// 初期局面からランダムに打って, 空きマスが empties 個の終盤局面を作る
+othello::State make_othello_endgame(const int empties, std::mt19937& engine) {
+    while (true) {
+        othello::State state;
+        while (!state.is_done() && state.count_empties() > empties) {
+            const auto legal_actions = state.legal_actions();
+            state.step(legal_actions.empty() ? othello::NO_POS : legal_actions[engine() % legal_actions.size()]);
+        }
+        if (!state.is_done() && state.count_empties() == empties) {
+            return state;
+        }
+    }
+}
+
+int main() {
+    std::cout << "position\tdf-pn\tnodes\ttime [s]\tand/or\tnodes\ttime [s]" << std::endl;
+    compare("tic_tac_toe (win)", tic_tac_toe::State(), false);
+    compare("tic_tac_toe (draw)", tic_tac_toe::State(), true);
+
+    std::mt19937 engine(0);
+    for (const int empties : {10, 14, 18}) {
+        for (int t = 0; t < 3; ++t) {
+            compare("othello " + std::to_string(empties) + " empties", make_othello_endgame(empties, engine), false);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,175 @@
+/*
+m,n,k ゲームでの探索の比較
+三目並べより大きな盤面で, 08.dfs と同じトランスポジションテーブル付きの全節点探索と,
+09.and_or と同じ AND/OR 木探索, df-pn で先手の勝敗を求めて時間を比較する
+*/
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "games/mnk_game.hpp"
+#include "games/play.hpp"
+#include "utils/df_pn.hpp"
+#include "utils/transposition_table.hpp"
+
+static constexpr std::size_t TABLE_SIZE_MB = 256;
+
+static int64_t node_count = 0;
+
+// 08.dfs と同じく, 同一局面を除いてすべての節点を訪問する. 手番側から見た勝敗 (1, 0, -1) を返す
+template <class State>
+int dfs(const State& state, TranspositionTable<int>& state_values) {
+    ++node_count;
+    int state_value = -1;
+    switch (state.get_winning_status()) {
+    case WinningStatus::WIN:
+        state_value = 1;
+        break;
+    case WinningStatus::LOSE:
+        state_value = -1;
+        break;
+    case WinningStatus::DRAW:
+        state_value = 0;
+        break;
+    default:
+        break;
+    }
+    if (state.is_done()) {
+        state_values.store(state.hash_value, state_value);
+        return state_value;
+    }
+    for (const auto action : state.legal_actions()) {
+        State next_state = state;
+        next_state.step(action);
+        int value;
+        if (const auto* stored = state_values.find(next_state.hash_value); stored != nullptr) {
+            value = -*stored;
+        } else {
+            value = -dfs(next_state, state_values);
+        }
+        if (value > state_value) {
+            state_value = value;
+        }
+    }
+    state_values.store(state.hash_value, state_value);
+    return state_value;
+}
+
+// 09.and_or と同じ AND/OR 木探索
+template <class State>
+bool or_score(const State& state, const bool is_draw_win);
+
+template <class State>
+bool and_score(const State& state, const bool is_draw_win) {
+    ++node_count;
+    switch (state.get_winning_status()) {
+    case WinningStatus::LOSE:
+        return true;
+    case WinningStatus::WIN:
+        return false;
+    case WinningStatus::DRAW:
+        return is_draw_win;
+    default:
+        for (const auto action : state.legal_actions()) {
+            State next_state = state;
+            next_state.step(action);
+            if (!or_score(next_state, is_draw_win)) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+template <class State>
+bool or_score(const State& state, const bool is_draw_win) {
+    ++node_count;
+    switch (state.get_winning_status()) {
+    case WinningStatus::WIN:
+        return true;
+    case WinningStatus::LOSE:
+        return false;
+    case WinningStatus::DRAW:
+        return is_draw_win;
+    default:
+        for (const auto action : state.legal_actions()) {
+            State next_state = state;
+            next_state.step(action);
+            if (and_score(next_state, is_draw_win)) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+double seconds_since(const std::chrono::high_resolution_clock::time_point start_time) {
+    return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+}
+
+std::string to_string(const int value) {
+    return value > 0 ? "win" : (value < 0 ? "lose" : "draw");
+}
+
+// 勝ち, 負けないこと の順に df-pn で証明して先手の勝敗を求める
+template <class State>
+int df_pn_value(const State& state, df_pn::Solver<State>& win_solver, df_pn::Solver<State>& draw_solver, int64_t& df_pn_node_count) {
+    if (win_solver.solve(state) == df_pn::Result::PROVEN) {
+        df_pn_node_count = win_solver.node_count();
+        return 1;
+    }
+    const bool is_not_lose = draw_solver.solve(state) == df_pn::Result::PROVEN;
+    df_pn_node_count = win_solver.node_count() + draw_solver.node_count();
+    return is_not_lose ? 0 : -1;
+}
+
+template <class State>
+int and_or_value(const State& state) {
+    if (or_score(state, false)) {
+        return 1;
+    }
+    return or_score(state, true) ? 0 : -1;
+}
+
+// use_and_or: AND/OR 木探索も実行するか (大きな盤面では終わらない)
+template <class State>
+void compare(const std::string& name, const bool use_dfs, const bool use_and_or) {
+    const State state;
+    std::cout << name;
+    if (use_dfs) {
+        node_count = 0;
+        // 表の確保は時間に含めない
+        TranspositionTable<int> state_values(TABLE_SIZE_MB);
+        const auto start_time = std::chrono::high_resolution_clock::now();
+        const int value = dfs(state, state_values);
+        std::cout << '\t' << to_string(value) << '\t' << node_count << '\t' << seconds_since(start_time);
+    } else {
+        std::cout << "\t-\t-\t-";
+    }
+    if (use_and_or) {
+        node_count = 0;
+        const auto start_time = std::chrono::high_resolution_clock::now();
+        const int value = and_or_value(state);
+        std::cout << '\t' << to_string(value) << '\t' << node_count << '\t' << seconds_since(start_time);
+    } else {
+        std::cout << "\t-\t-\t-";
+    }
+    // 表の確保は時間に含めない
+    df_pn::Solver<State> win_solver(TABLE_SIZE_MB, false);
+    df_pn::Solver<State> draw_solver(TABLE_SIZE_MB, true);
+    int64_t df_pn_node_count = 0;
+    const auto start_time = std::chrono::high_resolution_clock::now();
+    const int value = df_pn_value(state, win_solver, draw_solver, df_pn_node_count);
+    std::cout << '\t' << to_string(value) << '\t' << df_pn_node_count << '\t' << seconds_since(start_time) << std::endl;
+}
+
+int main() {
+    std::cout << "board\tdfs\tnodes\ttime [s]\tand/or\tnodes\ttime [s]\tdf-pn\tnodes\ttime [s]" << std::endl;
+    compare<mnk_game::MNKState<3, 3, 3>>("3x3x3", true, true);
+    compare<mnk_game::MNKState<4, 3, 3>>("4x3x3", true, true);
+    compare<mnk_game::MNKState<4, 4, 3>>("4x4x3", true, true);
+    compare<mnk_game::MNKState<4, 4, 4>>("4x4x4", true, false);
+    compare<mnk_game::MNKState<5, 4, 4>>("5x4x4", false, false);
+    return 0;
+}
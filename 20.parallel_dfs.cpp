@@ -0,0 +1,104 @@
+/*
+並列深さ優先探索ですべての節点を訪問
+08.dfs と同じく同一局面を除いて節点を数えるが, 浅い部分木をタスクとしてワークスティーリング方式のスレッドプールに分配する
+訪問済みの局面はロックフリーなハッシュ集合で共有し, 節点数はスレッドごとに数えて最後に合計する
+スレッド数を変えて実行時間を計測し, 1 スレッドに対する速度向上率を出力する
+使い方: parallel_dfs [最大スレッド数]
+*/
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "games/mnk_game.hpp"
+#include "games/tic_tac_toe.hpp"
+#include "utils/concurrent_hash_set.hpp"
+#include "utils/thread_pool.hpp"
+
+// この深さまでの節点は子をタスクとして積む. それより深い節点は同じスレッドで再帰する
+static constexpr int SPLIT_DEPTH = 4;
+static constexpr std::size_t TABLE_SIZE_MB = 256;
+
+// false sharing を避けるため, スレッドごとのカウンタをキャッシュラインに揃える
+struct alignas(64) NodeCounter {
+    int64_t count = 0;
+};
+
+template <class State>
+class ParallelEnumerator {
+public:
+    explicit ParallelEnumerator(const int thread_count)
+        : pool_(thread_count), node_counters_(thread_count), visited_(TABLE_SIZE_MB)
+    {}
+
+    int64_t enumerate(const State& root) {
+        visited_.insert(root.hash_value);
+        pool_.submit([this, root] { visit(root, 0); });
+        pool_.wait_idle();
+        int64_t node_count = 0;
+        for (const auto& counter : node_counters_) {
+            node_count += counter.count;
+        }
+        return node_count;
+    }
+
+    int64_t steal_count() const {
+        return pool_.steal_count();
+    }
+
+    std::size_t overflow_count() const {
+        return visited_.overflow_count();
+    }
+
+private:
+    WorkStealingPool pool_;
+    std::vector<NodeCounter> node_counters_;
+    ConcurrentHashSet visited_;
+
+    void visit(const State& state, const int depth) {
+        ++node_counters_[WorkStealingPool::thread_index()].count;
+        if (state.is_done()) {
+            return;
+        }
+        for (const auto action : state.legal_actions()) {
+            State next_state = state;
+            next_state.step(action);
+            // 最初に訪問したスレッドだけが部分木を探索する
+            if (!visited_.insert(next_state.hash_value)) {
+                continue;
+            }
+            if (depth < SPLIT_DEPTH) {
+                pool_.submit([this, next_state, depth] { visit(next_state, depth + 1); });
+            } else {
+                visit(next_state, depth + 1);
+            }
+        }
+    }
+};
+
+template <class State>
+void measure(const std::string& name, const int max_thread_count) {
+    double base_seconds = 0;
+    for (int thread_count = 1; thread_count <= max_thread_count; thread_count *= 2) {
+        ParallelEnumerator<State> enumerator(thread_count);
+        const auto start_time = std::chrono::high_resolution_clock::now();
+        const int64_t node_count = enumerator.enumerate(State());
+        const double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+        if (thread_count == 1) {
+            base_seconds = seconds;
+        }
+        std::cout << name << '\t' << thread_count << '\t' << node_count << '\t' << seconds << '\t' << base_seconds / seconds << '\t'
+                  << enumerator.steal_count() << '\t' << enumerator.overflow_count() << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const int max_thread_count = argc > 1 ? std::stoi(argv[1]) : std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "board\tthreads\tvisited node\ttime [s]\tspeedup\tsteals\toverflow" << std::endl;
+    measure<tic_tac_toe::State>("tic_tac_toe", max_thread_count);
+    measure<mnk_game::MNKState<4, 4, 3>>("4x4x3", max_thread_count);
+    measure<mnk_game::MNKState<4, 4, 4>>("4x4x4", max_thread_count);
+    return 0;
+}
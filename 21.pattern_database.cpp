@@ -0,0 +1,181 @@
+/*
+15 パズルのパターンデータベースの生成
+パターンのコマと空白の位置だけを区別した抽象状態を, 終端状態から後ろ向きに幅優先探索する
+パターンのコマを動かす手はコスト 1, パターン外のコマを動かす (空白だけが動く) 手はコスト 0 の 0-1 幅優先探索で,
+コストの層ごとに, 同じ層の中をコスト 0 の手で広げきってから次の層に進む
+各層の状態を塊に分けてスレッドプールで並列に展開し, 訪問済みの判定はビット配列への fetch_or で行う
+配置ごとに, 空白の位置について最小のコストを 1 バイトで data/ に書き出す (fifteen_puzzle_pdb の形式)
+使い方: pattern_database [スレッド数] [出力ディレクトリ]
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "games/fifteen_puzzle.hpp"
+#include "games/fifteen_puzzle_pdb.hpp"
+#include "utils/thread_pool.hpp"
+
+using fifteen_puzzle::Pattern;
+
+// 1 つのタスクで展開する状態の数
+static constexpr std::size_t CHUNK_SIZE = 1 << 14;
+static constexpr uint8_t UNKNOWN = 0xFF;
+
+// 抽象状態は 4 ビットごとに, パターンの i 番目のコマのセル (i < k) と空白のセル (i = k) を詰めた整数
+using AbstractState = uint32_t;
+
+class PatternDatabaseGenerator {
+public:
+    PatternDatabaseGenerator(const Pattern& pattern, const int thread_count)
+        : pattern_(pattern), k_(pattern.size()), pool_(thread_count),
+          visited_((uint64_t(fifteen_puzzle::placement_count(k_)) * 16 + 63) / 64),
+          entries_(fifteen_puzzle::placement_count(k_), UNKNOWN),
+          same_level_(pool_.thread_count()), next_level_(pool_.thread_count())
+    {}
+
+    std::vector<uint8_t> generate() {
+        AbstractState goal = 0;
+        for (int i = 0; i < k_; ++i) {
+            goal |= AbstractState(fifteen_puzzle::terminal_positions[pattern_[i]]) << (i << 2);
+        }
+        goal |= AbstractState(fifteen_puzzle::terminal_positions[0]) << (k_ << 2);
+        std::vector<AbstractState> candidates = {goal};
+        for (int cost = 0; !candidates.empty(); ++cost) {
+            // 前の層でコスト 1 の手により見つかった状態のうち, まだ訪問していないものがこの層の状態
+            run_parallel(candidates, [this](const AbstractState state, const int thread_index) {
+                if (test_and_set(state)) {
+                    same_level_[thread_index].emplace_back(state);
+                }
+            });
+            int64_t level_size = 0;
+            for (auto wave = gather(same_level_); !wave.empty(); wave = gather(same_level_)) {
+                level_size += wave.size();
+                run_parallel(wave, [this, cost](const AbstractState state, const int thread_index) {
+                    expand(state, cost, thread_index);
+                });
+            }
+            candidates = gather(next_level_);
+            std::cout << "cost\t" << cost << "\tstates\t" << level_size << std::endl;
+        }
+        return entries_;
+    }
+
+private:
+    Pattern pattern_;
+    int k_;
+    WorkStealingPool pool_;
+    std::vector<std::atomic<uint64_t>> visited_;
+    std::vector<uint8_t> entries_;
+    // スレッドごとの, 同じ層 (コスト 0 の手) と次の層 (コスト 1 の手) で見つかった状態
+    std::vector<std::vector<AbstractState>> same_level_;
+    std::vector<std::vector<AbstractState>> next_level_;
+
+    uint64_t index(const AbstractState state) const {
+        int cells[16];
+        for (int i = 0; i < k_; ++i) {
+            cells[i] = (state >> (i << 2)) & 0xF;
+        }
+        return uint64_t(fifteen_puzzle::rank_placement(cells, k_)) * 16 + ((state >> (k_ << 2)) & 0xF);
+    }
+
+    bool is_visited(const AbstractState state) const {
+        const uint64_t i = index(state);
+        return visited_[i >> 6].load(std::memory_order_relaxed) >> (i & 63) & 1;
+    }
+
+    // 初めて訪問したら true
+    bool test_and_set(const AbstractState state) {
+        const uint64_t i = index(state);
+        const uint64_t bit = uint64_t(1) << (i & 63);
+        return !(visited_[i >> 6].fetch_or(bit, std::memory_order_relaxed) & bit);
+    }
+
+    void expand(const AbstractState state, const int cost, const int thread_index) {
+        static constexpr int move_amount[4] = {-1, 1, -4, 4};
+        int cells[16];
+        // owners[セル番号] = そのセルにあるパターンのコマの順番 (無ければ -1)
+        int owners[16];
+        std::fill(owners, owners + 16, -1);
+        for (int i = 0; i < k_; ++i) {
+            cells[i] = (state >> (i << 2)) & 0xF;
+            owners[cells[i]] = i;
+        }
+        // 同じ層の状態はどれも同じコストなので, 書き込みが競合しても値は変わらない
+        std::atomic_ref<uint8_t> entry(entries_[fifteen_puzzle::rank_placement(cells, k_)]);
+        if (entry.load(std::memory_order_relaxed) == UNKNOWN) {
+            entry.store(cost, std::memory_order_relaxed);
+        }
+        const int zero = (state >> (k_ << 2)) & 0xF;
+        const auto [zero_h, zero_w] = fifteen_puzzle::get_coordinate(zero);
+        const bool is_legal[4] = {zero_w != 0, zero_w != 3, zero_h != 0, zero_h != 3};
+        for (int action = 0; action < 4; ++action) {
+            if (!is_legal[action]) {
+                continue;
+            }
+            const int moved_zero = zero + move_amount[action];
+            AbstractState next_state = (state & ~(AbstractState(0xF) << (k_ << 2))) | (AbstractState(moved_zero) << (k_ << 2));
+            if (const int owner = owners[moved_zero]; owner >= 0) {
+                next_state = (next_state & ~(AbstractState(0xF) << (owner << 2))) | (AbstractState(zero) << (owner << 2));
+                if (!is_visited(next_state)) {
+                    next_level_[thread_index].emplace_back(next_state);
+                }
+            } else if (test_and_set(next_state)) {
+                same_level_[thread_index].emplace_back(next_state);
+            }
+        }
+    }
+
+    template <class Function>
+    void run_parallel(const std::vector<AbstractState>& states, Function function) {
+        for (std::size_t begin = 0; begin < states.size(); begin += CHUNK_SIZE) {
+            const std::size_t end = std::min(states.size(), begin + CHUNK_SIZE);
+            pool_.submit([&states, &function, begin, end] {
+                const int thread_index = WorkStealingPool::thread_index();
+                for (std::size_t i = begin; i < end; ++i) {
+                    function(states[i], thread_index);
+                }
+            });
+        }
+        pool_.wait_idle();
+    }
+
+    static std::vector<AbstractState> gather(std::vector<std::vector<AbstractState>>& outputs) {
+        std::vector<AbstractState> states;
+        for (auto& output : outputs) {
+            states.insert(states.end(), output.begin(), output.end());
+            output.clear();
+        }
+        return states;
+    }
+};
+
+int main(int argc, char* argv[]) {
+    const int thread_count = argc > 1 ? std::stoi(argv[1]) : std::max(1u, std::thread::hardware_concurrency());
+    const std::string directory = argc > 2 ? argv[2] : "data";
+    std::filesystem::create_directories(directory);
+    for (const auto& pattern : fifteen_puzzle::PARTITION_663) {
+        const std::string path = directory + "/" + fifteen_puzzle::AdditivePatternDatabase::file_name(pattern);
+        std::cout << "generating\t" << path << std::endl;
+        const auto start_time = std::chrono::high_resolution_clock::now();
+        PatternDatabaseGenerator generator(pattern, thread_count);
+        const auto entries = generator.generate();
+        const double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+        double average = 0;
+        for (const auto entry : entries) {
+            average += entry;
+        }
+        average /= entries.size();
+        std::cout << "entries\t" << entries.size() << "\taverage\t" << average << "\ttime [s]\t" << seconds << std::endl;
+        if (!fifteen_puzzle::PatternDatabase::save(path, pattern, entries)) {
+            std::cerr << "Error: cannot write " << path << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+/*
+パターンデータベースの性能比較
+問題集の各問題を, 6-6-3 の加算的パターンデータベースを h コストとする反復深化 A* 探索で解く
+先頭の数問はマンハッタン距離でも解き, 最短手数が一致することと探索節点数の違いを確認する
+問題集は Korf の 100 問の形式 (fifteen_puzzle::load_instances を参照). リポジトリには含めていない
+パターンデータベースは先に pattern_database で生成しておく
+使い方: pattern_database_benchmark [問題集のパス] [マンハッタン距離でも解く問題数] [パターンデータベースのディレクトリ]
+*/
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "games/fifteen_puzzle.hpp"
+#include "games/fifteen_puzzle_pdb.hpp"
+#include "utils/ida_star.hpp"
+
+using State = fifteen_puzzle::State;
+
+struct Result {
+    int length;
+    int64_t node_count;
+    double seconds;
+};
+
+template <class Solver>
+Result solve(Solver& solver, const State& state) {
+    const auto start_time = std::chrono::high_resolution_clock::now();
+    const auto actions = solver.solve(state);
+    const double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+    return {static_cast<int>(actions.size()), solver.total_node_count(), seconds};
+}
+
+int main(int argc, char* argv[]) {
+    const std::string instances_path = argc > 1 ? argv[1] : "data/korf100.txt";
+    const int manhattan_count = argc > 2 ? std::stoi(argv[2]) : 5;
+    const std::string directory = argc > 3 ? argv[3] : "data";
+
+    std::vector<State> instances;
+    if (!fifteen_puzzle::load_instances(instances_path, instances)) {
+        std::cerr << "Error: cannot load " << instances_path << std::endl;
+        return 1;
+    }
+    const auto load_start_time = std::chrono::high_resolution_clock::now();
+    fifteen_puzzle::AdditivePatternDatabase database;
+    if (!database.load(directory)) {
+        std::cerr << "Error: cannot load pattern databases in " << directory << ". Run pattern_database first." << std::endl;
+        return 1;
+    }
+    const double load_seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - load_start_time).count();
+    std::cout << "load time [s]\t" << load_seconds << std::endl;
+
+    ida_star::Solver<State> manhattan_solver;
+    ida_star::Solver<State, fifteen_puzzle::PatternDatabaseHeuristic> pdb_solver({&database});
+    Result pdb_total{0, 0, 0};
+    Result manhattan_total{0, 0, 0};
+    int64_t compared_pdb_node_count = 0;
+    std::cout << "instance\tinitial h\tlength\tnodes\ttime [s]\tmanhattan initial h\tmanhattan nodes\tmanhattan time [s]" << std::endl;
+    for (std::size_t i = 0; i < instances.size(); ++i) {
+        const auto pdb_result = solve(pdb_solver, instances[i]);
+        pdb_total.length += pdb_result.length;
+        pdb_total.node_count += pdb_result.node_count;
+        pdb_total.seconds += pdb_result.seconds;
+        std::cout << i + 1 << '\t' << database(instances[i]) << '\t' << pdb_result.length << '\t' << pdb_result.node_count << '\t' << pdb_result.seconds;
+        if (static_cast<int>(i) < manhattan_count) {
+            const auto manhattan_result = solve(manhattan_solver, instances[i]);
+            if (manhattan_result.length != pdb_result.length) {
+                std::cerr << "Error: shortest path lengths differ" << std::endl;
+                return 1;
+            }
+            manhattan_total.node_count += manhattan_result.node_count;
+            manhattan_total.seconds += manhattan_result.seconds;
+            compared_pdb_node_count += pdb_result.node_count;
+            std::cout << '\t' << instances[i].h_cost << '\t' << manhattan_result.node_count << '\t' << manhattan_result.seconds;
+        }
+        std::cout << std::endl;
+    }
+    std::cout << "pattern database\tinstances\t" << instances.size() << "\taverage length\t" << static_cast<double>(pdb_total.length) / instances.size()
+              << "\tnodes\t" << pdb_total.node_count << "\ttime [s]\t" << pdb_total.seconds << "\tnodes/sec\t" << pdb_total.node_count / pdb_total.seconds << std::endl;
+    if (manhattan_total.node_count) {
+        std::cout << "manhattan\tinstances\t" << std::min<int>(manhattan_count, instances.size()) << "\tnodes\t" << manhattan_total.node_count
+                  << "\ttime [s]\t" << manhattan_total.seconds << "\tnodes/sec\t" << manhattan_total.node_count / manhattan_total.seconds
+                  << "\tnode ratio (pattern database / manhattan)\t" << static_cast<double>(compared_pdb_node_count) / manhattan_total.node_count << std::endl;
+    }
+    return 0;
+}
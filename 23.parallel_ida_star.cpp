@@ -0,0 +1,87 @@
+/*
+並列反復深化 A* 探索
+同じ問題を, スレッド数を変えて utils/parallel_ida_star で解き, 1 スレッドに対する速度向上率と
+スレッドごとの探索節点数の偏り (最大値 / 平均値) を出力する
+h コストは linear conflict を使う
+使い方: parallel_ida_star [最大スレッド数] [問題集のパス (省略するとランダムな 5 問)]
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "games/fifteen_puzzle.hpp"
+#include "utils/ida_star.hpp"
+#include "utils/parallel_ida_star.hpp"
+
+using State = fifteen_puzzle::BasicFifteenPuzzleState<fifteen_puzzle::heuristic::LinearConflict>;
+
+// フロンティアの節点数の目安
+static constexpr std::size_t FRONTIER_SIZE = 4096;
+static constexpr int RANDOM_INSTANCE_COUNT = 5;
+
+int main(int argc, char* argv[]) {
+    const int max_thread_count = argc > 1 ? std::stoi(argv[1]) : std::max(1u, std::thread::hardware_concurrency());
+    std::vector<State> instances;
+    if (argc > 2) {
+        if (!fifteen_puzzle::load_instances(argv[2], instances)) {
+            std::cerr << "Error: cannot load " << argv[2] << std::endl;
+            return 1;
+        }
+    } else {
+        for (int i = 0; i < RANDOM_INSTANCE_COUNT; ++i) {
+            instances.emplace_back(fifteen_puzzle::random_walk_board());
+        }
+    }
+
+    // 逐次版の結果を基準とする
+    std::vector<int> lengths;
+    double sequential_seconds = 0;
+    int64_t sequential_node_count = 0;
+    for (const auto& instance : instances) {
+        ida_star::Solver<State> solver;
+        const auto start_time = std::chrono::high_resolution_clock::now();
+        lengths.emplace_back(solver.solve(instance).size());
+        sequential_seconds += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+        sequential_node_count += solver.total_node_count();
+    }
+    std::cout << "threads\ttime [s]\tnodes\tnodes/sec\tspeedup\tsteals\timbalance\tnodes per thread" << std::endl;
+    std::cout << "sequential\t" << sequential_seconds << '\t' << sequential_node_count << '\t' << sequential_node_count / sequential_seconds << std::endl;
+
+    for (int thread_count = 1; thread_count <= max_thread_count; thread_count *= 2) {
+        ida_star::ParallelSolver<State> solver(thread_count, FRONTIER_SIZE);
+        double seconds = 0;
+        int64_t node_count = 0;
+        std::vector<int64_t> thread_node_counts(thread_count, 0);
+        for (std::size_t i = 0; i < instances.size(); ++i) {
+            const auto start_time = std::chrono::high_resolution_clock::now();
+            const auto actions = solver.solve(instances[i]);
+            seconds += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+            if (static_cast<int>(actions.size()) != lengths[i]) {
+                std::cerr << "Error: shortest path lengths differ" << std::endl;
+                return 1;
+            }
+            node_count += solver.total_node_count();
+            const auto counts = solver.thread_node_counts();
+            for (int thread = 0; thread < thread_count; ++thread) {
+                thread_node_counts[thread] += counts[thread];
+            }
+        }
+        int64_t max_thread_node_count = 0;
+        int64_t sum_thread_node_count = 0;
+        for (const auto count : thread_node_counts) {
+            max_thread_node_count = std::max(max_thread_node_count, count);
+            sum_thread_node_count += count;
+        }
+        std::cout << thread_count << '\t' << seconds << '\t' << node_count << '\t' << node_count / seconds << '\t' << sequential_seconds / seconds << '\t'
+                  << solver.steal_count() << '\t' << static_cast<double>(max_thread_node_count) * thread_count / sum_thread_node_count << '\t';
+        for (int thread = 0; thread < thread_count; ++thread) {
+            std::cout << (thread ? " " : "") << thread_node_counts[thread];
+        }
+        std::cout << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,82 @@
+/*
+HDA* (Hash Distributed A*)
+同じ問題を, 逐次の utils/a_star とスレッド数を変えた utils/hda_star で解き, 最短経路の長さが一致することを確かめて
+展開節点数, 毎秒の展開節点数, 逐次版に対する速度向上率, 他のスレッドへ送った節点の割合, スレッドごとの展開節点数の偏り (最大値 / 平均値) を出力する
+h コストは linear conflict を使う
+使い方: hda_star [最大スレッド数] [問題集のパス (省略するとランダムな 5 問)]
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "games/fifteen_puzzle.hpp"
+#include "utils/a_star.hpp"
+#include "utils/hda_star.hpp"
+
+using State = fifteen_puzzle::BasicFifteenPuzzleState<fifteen_puzzle::heuristic::LinearConflict>;
+
+static constexpr int RANDOM_INSTANCE_COUNT = 5;
+
+int main(int argc, char* argv[]) {
+    const int max_thread_count = argc > 1 ? std::stoi(argv[1]) : std::max(1u, std::thread::hardware_concurrency());
+    std::vector<State> instances;
+    if (argc > 2) {
+        if (!fifteen_puzzle::load_instances(argv[2], instances)) {
+            std::cerr << "Error: cannot load " << argv[2] << std::endl;
+            return 1;
+        }
+    } else {
+        for (int i = 0; i < RANDOM_INSTANCE_COUNT; ++i) {
+            instances.emplace_back(fifteen_puzzle::random_walk_board());
+        }
+    }
+
+    // 逐次版の結果を基準とする
+    std::vector<std::size_t> lengths;
+    double sequential_seconds = 0;
+    int64_t sequential_expanded_count = 0;
+    for (const auto& instance : instances) {
+        a_star::Solver<State> solver;
+        const auto start_time = std::chrono::high_resolution_clock::now();
+        lengths.emplace_back(solver.solve(instance).size());
+        sequential_seconds += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+        sequential_expanded_count += solver.expanded_count();
+    }
+    std::cout << "threads\ttime [s]\texpanded\texpansions/sec\tspeedup\tsent ratio\timbalance\texpanded per thread" << std::endl;
+    std::cout << "sequential\t" << sequential_seconds << '\t' << sequential_expanded_count << '\t' << sequential_expanded_count / sequential_seconds << std::endl;
+
+    for (int thread_count = 1; thread_count <= max_thread_count; thread_count *= 2) {
+        hda_star::Solver<State> solver(thread_count);
+        double seconds = 0;
+        int64_t expanded_count = 0;
+        int64_t sent_count = 0;
+        std::vector<int64_t> thread_expanded_counts(thread_count, 0);
+        for (std::size_t i = 0; i < instances.size(); ++i) {
+            const auto start_time = std::chrono::high_resolution_clock::now();
+            const auto shortest_path = solver.solve(instances[i]);
+            seconds += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+            if (shortest_path.size() != lengths[i] || !shortest_path.back().is_done()) {
+                std::cerr << "Error: shortest path lengths differ" << std::endl;
+                return 1;
+            }
+            expanded_count += solver.expanded_count();
+            sent_count += solver.sent_count();
+            const auto counts = solver.thread_expanded_counts();
+            for (int thread = 0; thread < thread_count; ++thread) {
+                thread_expanded_counts[thread] += counts[thread];
+            }
+        }
+        const int64_t max_thread_expanded_count = *std::max_element(thread_expanded_counts.begin(), thread_expanded_counts.end());
+        std::cout << thread_count << '\t' << seconds << '\t' << expanded_count << '\t' << expanded_count / seconds << '\t' << sequential_seconds / seconds << '\t'
+                  << static_cast<double>(sent_count) / expanded_count << '\t' << static_cast<double>(max_thread_expanded_count) * thread_count / expanded_count << '\t';
+        for (int thread = 0; thread < thread_count; ++thread) {
+            std::cout << (thread ? " " : "") << thread_expanded_counts[thread];
+        }
+        std::cout << std::endl;
+    }
+    return 0;
+}
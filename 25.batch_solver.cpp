@@ -0,0 +1,148 @@
+/*
+15 パズルの一括求解
+問題集 (Korf の 100 問の形式) またはシードから生成した一様ランダムな解ける問題を, スレッドプールで並列に解き,
+問題ごとの最短手数, 展開節点数, 時間, メモリを CSV で出力する. 処理速度の回帰を確かめるためのベンチマーク
+h コストは linear conflict を使う
+使い方: batch_solver [入力] [スレッド数] [探索 (ida_star / a_star)] [出力する CSV のパス (省略すると標準出力)]
+  入力は問題集のパスか, random:問題数:シード (既定は random:10:1)
+  時間は問題ごとの経過時間なので, スレッド数が論理コア数を超えると長くなる
+  peak_rss_kb はその問題を解き終えた時点でのプロセス全体の最大常駐メモリ
+*/
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "games/fifteen_puzzle.hpp"
+#include "utils/a_star.hpp"
+#include "utils/ida_star.hpp"
+#include "utils/memory_usage.hpp"
+#include "utils/thread_pool.hpp"
+
+using State = fifteen_puzzle::BasicFifteenPuzzleState<fifteen_puzzle::heuristic::LinearConflict>;
+
+struct Result {
+    int length = 0;
+    int64_t expanded_count = 0;
+    double seconds = 0;
+    // 探索が確保したメモリ (バイト). 反復深化 A* は経路しか持たないので 0
+    std::size_t solver_bytes = 0;
+    long peak_rss_kb = 0;
+};
+
+// "random:問題数:シード" を読む. 形式が違えば false
+bool parse_random_spec(const std::string& spec, int& count, uint64_t& seed) {
+    if (spec.compare(0, 6, "random") != 0) {
+        return false;
+    }
+    count = 10;
+    seed = 1;
+    try {
+        const auto first = spec.find(':');
+        if (first == std::string::npos) {
+            return spec.size() == 6;
+        }
+        const auto second = spec.find(':', first + 1);
+        count = std::stoi(spec.substr(first + 1, second - first - 1));
+        if (second != std::string::npos) {
+            seed = std::stoull(spec.substr(second + 1));
+        }
+    } catch (const std::exception&) {
+        return false;
+    }
+    return count > 0;
+}
+
+Result solve(const State& instance, const bool use_a_star) {
+    Result result;
+    const auto start_time = std::chrono::high_resolution_clock::now();
+    if (use_a_star) {
+        a_star::Solver<State> solver;
+        result.length = static_cast<int>(solver.solve(instance).size()) - 1;
+        result.expanded_count = solver.expanded_count();
+        result.solver_bytes = solver.size_in_bytes();
+    } else {
+        ida_star::Solver<State> solver;
+        result.length = static_cast<int>(solver.solve(instance).size());
+        result.expanded_count = solver.total_node_count();
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+    result.peak_rss_kb = memory_usage::peak_rss_kb();
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    const std::string input = argc > 1 ? argv[1] : "random:10:1";
+    const int thread_count = argc > 2 ? std::stoi(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+    const std::string algorithm = argc > 3 ? argv[3] : "ida_star";
+    if (algorithm != "ida_star" && algorithm != "a_star") {
+        std::cerr << "Error: unknown algorithm " << algorithm << std::endl;
+        return 1;
+    }
+
+    std::vector<State> instances;
+    int random_count;
+    uint64_t seed;
+    if (parse_random_spec(input, random_count, seed)) {
+        std::mt19937_64 engine(seed);
+        for (int i = 0; i < random_count; ++i) {
+            instances.emplace_back(fifteen_puzzle::random_board(engine));
+        }
+    } else if (!fifteen_puzzle::load_instances(input, instances)) {
+        std::cerr << "Error: cannot load " << input << std::endl;
+        return 1;
+    }
+    for (const auto& instance : instances) {
+        if (!fifteen_puzzle::is_solvable(instance.board())) {
+            std::cerr << "Error: unsolvable instance in " << input << std::endl;
+            return 1;
+        }
+    }
+
+    std::ofstream ofs;
+    if (argc > 4) {
+        ofs.open(argv[4]);
+        if (!ofs) {
+            std::cerr << "Error: cannot open " << argv[4] << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& os = argc > 4 ? ofs : std::cout;
+
+    // 結果は問題の順に並べて出力するので, 解き終わった順序によらない
+    std::vector<Result> results(instances.size());
+    const auto start_time = std::chrono::high_resolution_clock::now();
+    {
+        WorkStealingPool pool(thread_count);
+        for (std::size_t i = 0; i < instances.size(); ++i) {
+            pool.submit([&, i] {
+                results[i] = solve(instances[i], algorithm == "a_star");
+            });
+        }
+        pool.wait_idle();
+    }
+    const double wall_seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+
+    os << "instance,initial_h,length,expanded,time_s,solver_bytes,peak_rss_kb" << std::endl;
+    int64_t total_length = 0;
+    int64_t total_expanded_count = 0;
+    double total_seconds = 0;
+    for (std::size_t i = 0; i < instances.size(); ++i) {
+        const auto& result = results[i];
+        os << i + 1 << ',' << instances[i].h_cost << ',' << result.length << ',' << result.expanded_count << ',' << result.seconds << ','
+           << result.solver_bytes << ',' << result.peak_rss_kb << std::endl;
+        total_length += result.length;
+        total_expanded_count += result.expanded_count;
+        total_seconds += result.seconds;
+    }
+    // 合計は # で始まる行にして, CSV として読むときに読み飛ばせるようにする
+    os << "# algorithm " << algorithm << ", threads " << thread_count << ", instances " << instances.size() << ", average length "
+       << static_cast<double>(total_length) / instances.size() << ", expanded " << total_expanded_count << ", wall time [s] " << wall_seconds
+       << ", summed time [s] " << total_seconds << ", expanded/sec " << total_expanded_count / wall_seconds << ", peak RSS [KB] "
+       << memory_usage::peak_rss_kb() << std::endl;
+    return 0;
+}
@@ -0,0 +1,66 @@
+/*
+重み付き A* 探索と ARA*
+同じ問題を, 重みを変えた重み付き A* 探索と, 時間制限つきの ARA* で解く
+重み付き A* 探索は重みごとに解の長さ, 展開節点数, 時間を出力し, ARA* は反復ごとに見つけた解の長さと最適性の上界を出力する
+最短経路の長さは utils/a_star で求めて比べる
+h コストは linear conflict を使う
+使い方: ara_star [時間制限 (ミリ秒)] [問題数] [シード]
+*/
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "games/fifteen_puzzle.hpp"
+#include "utils/a_star.hpp"
+#include "utils/ara_star.hpp"
+#include "utils/time_keeper.hpp"
+
+using State = fifteen_puzzle::BasicFifteenPuzzleState<fifteen_puzzle::heuristic::LinearConflict>;
+
+static constexpr double WEIGHTS[] = {1.0, 1.2, 1.5, 2.0, 3.0, 5.0};
+
+int main(int argc, char* argv[]) {
+    const int64_t time_threshold = argc > 1 ? std::stoll(argv[1]) : 1000;
+    const int instance_count = argc > 2 ? std::stoi(argv[2]) : 3;
+    const uint64_t seed = argc > 3 ? std::stoull(argv[3]) : 1;
+
+    std::mt19937_64 engine(seed);
+    for (int i = 0; i < instance_count; ++i) {
+        const State instance(fifteen_puzzle::random_board(engine));
+        a_star::Solver<State> optimal_solver;
+        const int optimal_length = static_cast<int>(optimal_solver.solve(instance).size()) - 1;
+        std::cout << "instance " << i + 1 << "\tinitial h\t" << instance.h_cost << "\tshortest path length\t" << optimal_length << std::endl;
+
+        std::cout << "weight\tlength\tratio\texpanded\ttime [s]" << std::endl;
+        for (const double weight : WEIGHTS) {
+            ara_star::Solver<State> solver;
+            const auto start_time = std::chrono::high_resolution_clock::now();
+            const int length = static_cast<int>(solver.solve(instance, weight).size()) - 1;
+            const double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+            if (length < optimal_length || length > weight * optimal_length) {
+                std::cerr << "Error: solution length is out of bound" << std::endl;
+                return 1;
+            }
+            std::cout << weight << '\t' << length << '\t' << static_cast<double>(length) / optimal_length << '\t' << solver.expanded_count() << '\t' << seconds << std::endl;
+        }
+
+        ara_star::Solver<State> solver;
+        const TimeKeeper time_keeper(time_threshold);
+        const int length = static_cast<int>(solver.solve(instance, time_keeper).size()) - 1;
+        std::cout << "ARA* (" << time_threshold << " ms)\ttime [ms]\tweight\tlength\tbound\texpanded" << std::endl;
+        for (const auto& solution : solver.solutions()) {
+            if (solution.length > solution.bound * optimal_length + 1e-9) {
+                std::cerr << "Error: solution length is out of bound" << std::endl;
+                return 1;
+            }
+            std::cout << '\t' << solution.microseconds / 1000.0 << '\t' << solution.weight << '\t' << solution.length << '\t' << solution.bound << '\t'
+                      << solution.expanded_count << std::endl;
+        }
+        std::cout << "result\tlength\t" << length << "\toptimal\t" << (solver.is_optimal() ? "yes" : "no") << "\tnodes\t" << solver.node_count() << std::endl
+                  << std::endl;
+    }
+    return 0;
+}
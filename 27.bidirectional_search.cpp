@@ -0,0 +1,75 @@
+/*
+双方向ヒューリスティック探索 (MM)
+同じ問題を, 前向きの A* 探索 (utils/a_star) と双方向の MM (utils/bidirectional_search) で解き,
+最短経路の長さが一致することを確かめて, 展開節点数, 時間, メモリを比べる
+h コストはどちらもマンハッタン距離 (後ろ向きは初期配置までのマンハッタン距離)
+使い方: bidirectional_search [問題数 (ランダムに生成する場合)] [問題集のパス (省略するとランダム)]
+*/
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "games/fifteen_puzzle.hpp"
+#include "utils/a_star.hpp"
+#include "utils/bidirectional_search.hpp"
+#include "utils/memory_usage.hpp"
+
+using State = fifteen_puzzle::State;
+
+int main(int argc, char* argv[]) {
+    const int instance_count = argc > 1 ? std::stoi(argv[1]) : 5;
+    std::vector<State> instances;
+    if (argc > 2) {
+        if (!fifteen_puzzle::load_instances(argv[2], instances)) {
+            std::cerr << "Error: cannot load " << argv[2] << std::endl;
+            return 1;
+        }
+    } else {
+        for (int i = 0; i < instance_count; ++i) {
+            instances.emplace_back(fifteen_puzzle::random_walk_board());
+        }
+    }
+    std::array<int, 16> terminal_board;
+    for (int number = 0; number < 16; ++number) {
+        terminal_board[fifteen_puzzle::terminal_positions[number]] = number;
+    }
+    const State goal_state(terminal_board);
+
+    std::cout << "instance\tlength\tA* expanded\tA* time [s]\tA* bytes\tMM expanded (forward + backward)\tMM time [s]\tMM bytes\texpanded ratio (MM / A*)" << std::endl;
+    int64_t total_a_star_expanded_count = 0;
+    int64_t total_mm_expanded_count = 0;
+    double total_a_star_seconds = 0;
+    double total_mm_seconds = 0;
+    for (std::size_t i = 0; i < instances.size(); ++i) {
+        a_star::Solver<State> a_star_solver;
+        auto start_time = std::chrono::high_resolution_clock::now();
+        const auto a_star_path = a_star_solver.solve(instances[i]);
+        const double a_star_seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+
+        using Solver = bidirectional_search::Solver<State, a_star::StateHeuristic, fifteen_puzzle::TargetManhattanHeuristic>;
+        Solver mm_solver({}, fifteen_puzzle::TargetManhattanHeuristic(instances[i].board()));
+        start_time = std::chrono::high_resolution_clock::now();
+        const auto mm_path = mm_solver.solve(instances[i], goal_state);
+        const double mm_seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+
+        if (mm_path.size() != a_star_path.size() || !mm_path.back().is_done()) {
+            std::cerr << "Error: shortest path lengths differ" << std::endl;
+            return 1;
+        }
+        std::cout << i + 1 << '\t' << a_star_path.size() - 1 << '\t' << a_star_solver.expanded_count() << '\t' << a_star_seconds << '\t'
+                  << a_star_solver.size_in_bytes() << '\t' << mm_solver.expanded_count() << " (" << mm_solver.forward_expanded_count() << " + "
+                  << mm_solver.backward_expanded_count() << ")\t" << mm_seconds << '\t' << mm_solver.size_in_bytes() << '\t'
+                  << static_cast<double>(mm_solver.expanded_count()) / a_star_solver.expanded_count() << std::endl;
+        total_a_star_expanded_count += a_star_solver.expanded_count();
+        total_mm_expanded_count += mm_solver.expanded_count();
+        total_a_star_seconds += a_star_seconds;
+        total_mm_seconds += mm_seconds;
+    }
+    std::cout << "total\t\t" << total_a_star_expanded_count << '\t' << total_a_star_seconds << "\t\t" << total_mm_expanded_count << '\t' << total_mm_seconds
+              << "\t\t" << static_cast<double>(total_mm_expanded_count) / total_a_star_expanded_count << std::endl;
+    std::cout << "peak RSS [KB]\t" << memory_usage::peak_rss_kb() << std::endl;
+    return 0;
+}
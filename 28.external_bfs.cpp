@@ -0,0 +1,71 @@
+/*
+外部メモリを使うフロンティア幅優先探索
+W x H のスライディングパズルの状態空間を, 終端状態から utils/external_bfs で幅優先探索し, 深さごとの状態数を出力する
+盤面は 1 セル 4 ビットに詰めた 64 ビット整数 (セル番号順にコマ番号, 空白は 0) で, 終端状態はセル i にコマ i + 1, 右下が空白
+3x3 (181440 状態, 最大 31 手), 2x5 (1814400 状態, 最大 55 手), 3x4 (239500800 状態, 最大 53 手) は調べ尽くせる
+4x4 は状態数が多すぎるので, 最大の深さを指定して部分空間を調べる
+使い方: external_bfs [盤面の大きさ (3x3, 2x5, 3x4, 4x4 など)] [最大の深さ] [スレッド数] [作業ディレクトリ] [分割数]
+*/
+
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "utils/external_bfs.hpp"
+#include "utils/memory_usage.hpp"
+
+using Key = external_bfs::Key;
+
+int main(int argc, char* argv[]) {
+    const std::string size = argc > 1 ? argv[1] : "3x3";
+    const int max_depth = argc > 2 ? std::stoi(argv[2]) : INT32_MAX;
+    const int thread_count = argc > 3 ? std::stoi(argv[3]) : std::max(1u, std::thread::hardware_concurrency());
+    const std::string directory = argc > 4 ? argv[4] : "data/external_bfs";
+    const int partition_count = argc > 5 ? std::stoi(argv[5]) : 64;
+
+    const auto separator = size.find('x');
+    const int height = separator == std::string::npos ? 0 : std::stoi(size.substr(0, separator));
+    const int width = separator == std::string::npos ? 0 : std::stoi(size.substr(separator + 1));
+    const int cell_count = height * width;
+    if (height < 2 || width < 2 || cell_count > 16) {
+        std::cerr << "Error: invalid board size " << size << std::endl;
+        return 1;
+    }
+
+    Key terminal_board = 0;
+    for (int cell = 0; cell + 1 < cell_count; ++cell) {
+        terminal_board |= Key(cell + 1) << (cell << 2);
+    }
+    // 空白を上下左右のセルと入れ替えた盤面を列挙する
+    auto expand = [height, width, cell_count](const Key board, auto emit) {
+        int zero_cell = 0;
+        while (zero_cell < cell_count && (board >> (zero_cell << 2) & 0xF) != 0) {
+            ++zero_cell;
+        }
+        const int h = zero_cell / width;
+        const int w = zero_cell % width;
+        auto slide = [&](const int cell) {
+            const Key number = board >> (cell << 2) & 0xF;
+            emit(board ^ (number << (cell << 2)) ^ (number << (zero_cell << 2)));
+        };
+        if (h > 0) slide(zero_cell - width);
+        if (h + 1 < height) slide(zero_cell + width);
+        if (w > 0) slide(zero_cell - 1);
+        if (w + 1 < width) slide(zero_cell + 1);
+    };
+
+    external_bfs::Searcher searcher(directory, thread_count, partition_count);
+    if (!searcher.run(terminal_board, expand, max_depth)) {
+        std::cerr << "Error: external BFS failed in " << directory << std::endl;
+        return 1;
+    }
+    std::cout << "depth\tstates\tgenerated\tmax partition\ttime [s]" << std::endl;
+    double total_seconds = 0;
+    for (const auto& layer : searcher.layers()) {
+        std::cout << layer.depth << '\t' << layer.count << '\t' << layer.generated_count << '\t' << layer.max_partition_size << '\t' << layer.seconds << std::endl;
+        total_seconds += layer.seconds;
+    }
+    std::cout << "size\t" << size << "\tstates\t" << searcher.total_count() << "\tmax depth\t" << searcher.layers().back().depth << "\ttime [s]\t" << total_seconds
+              << "\tpeak RSS [KB]\t" << memory_usage::peak_rss_kb() << std::endl;
+    return 0;
+}
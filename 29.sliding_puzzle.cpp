@@ -0,0 +1,113 @@
+/*
+W x H のスライディングパズル
+games/sliding_puzzle の状態を, 15 パズルと同じ A* 探索 (utils/a_star) と反復深化 A* 探索 (utils/ida_star) で解く
+  8 パズル  : 一様ランダムな問題を A* 探索 (マンハッタン距離) と反復深化 A* 探索 (linear conflict) で解き, 最短手数が一致することを確かめる
+  15 パズル : 一様ランダムな問題を反復深化 A* 探索で, linear conflict と games/fifteen_puzzle の walking distance の両方で解き比べる
+  24 パズル : 終端状態からランダムにスライドさせた問題を反復深化 A* 探索 (linear conflict) で解く
+使い方: sliding_puzzle [8 パズルの問題数] [15 パズルの問題数] [24 パズルの問題数] [24 パズルのスライド回数] [シード]
+*/
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "games/fifteen_puzzle.hpp"
+#include "games/sliding_puzzle.hpp"
+#include "utils/a_star.hpp"
+#include "utils/ida_star.hpp"
+
+template <int W, int H>
+using LinearConflictState = sliding_puzzle::BasicSlidingPuzzleState<W, H, sliding_puzzle::heuristic::LinearConflict>;
+
+struct Result {
+    int64_t length = 0;
+    int64_t node_count = 0;
+    double seconds = 0;
+};
+
+template <class State>
+Result solve_ida_star(const State& instance) {
+    ida_star::Solver<State> solver;
+    const auto start_time = std::chrono::high_resolution_clock::now();
+    const auto actions = solver.solve(instance);
+    const double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+    return {static_cast<int64_t>(actions.size()), solver.total_node_count(), seconds};
+}
+
+template <class State>
+Result solve_a_star(const State& instance) {
+    a_star::Solver<State> solver;
+    const auto start_time = std::chrono::high_resolution_clock::now();
+    const auto path = solver.solve(instance);
+    const double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+    return {static_cast<int64_t>(path.size()) - 1, solver.expanded_count(), seconds};
+}
+
+void print(const std::string& name, const Result& result, const int instance_count) {
+    std::cout << name << '\t' << instance_count << '\t' << static_cast<double>(result.length) / instance_count << '\t' << result.node_count << '\t'
+              << result.seconds << '\t' << result.node_count / result.seconds << std::endl;
+}
+
+void add(Result& total, const Result& result) {
+    total.length += result.length;
+    total.node_count += result.node_count;
+    total.seconds += result.seconds;
+}
+
+int main(int argc, char* argv[]) {
+    const int eight_count = argc > 1 ? std::stoi(argv[1]) : 1000;
+    const int fifteen_count = argc > 2 ? std::stoi(argv[2]) : 3;
+    const int twenty_four_count = argc > 3 ? std::stoi(argv[3]) : 3;
+    const int twenty_four_moves = argc > 4 ? std::stoi(argv[4]) : 60;
+    const uint64_t seed = argc > 5 ? std::stoull(argv[5]) : 1;
+    std::mt19937_64 engine(seed);
+
+    std::cout << "puzzle / solver\tinstances\taverage length\tnodes\ttime [s]\tnodes/sec" << std::endl;
+
+    Result eight_a_star;
+    Result eight_ida_star;
+    for (int i = 0; i < eight_count; ++i) {
+        const auto numbers = sliding_puzzle::random_board<3, 3>(engine);
+        const auto a_star_result = solve_a_star(sliding_puzzle::EightPuzzleState(numbers));
+        const auto ida_star_result = solve_ida_star(LinearConflictState<3, 3>(numbers));
+        if (a_star_result.length != ida_star_result.length) {
+            std::cerr << "Error: shortest path lengths differ" << std::endl;
+            return 1;
+        }
+        add(eight_a_star, a_star_result);
+        add(eight_ida_star, ida_star_result);
+    }
+    print("8 / a_star (manhattan)", eight_a_star, eight_count);
+    print("8 / ida_star (linear conflict)", eight_ida_star, eight_count);
+
+    Result fifteen_linear_conflict;
+    Result fifteen_walking_distance;
+    for (int i = 0; i < fifteen_count; ++i) {
+        const auto numbers = sliding_puzzle::random_board<4, 4>(engine);
+        const auto linear_conflict_result = solve_ida_star(LinearConflictState<4, 4>(numbers));
+        const auto walking_distance_result = solve_ida_star(fifteen_puzzle::BasicFifteenPuzzleState<fifteen_puzzle::heuristic::WalkingDistance>(numbers));
+        if (linear_conflict_result.length != walking_distance_result.length) {
+            std::cerr << "Error: shortest path lengths differ" << std::endl;
+            return 1;
+        }
+        add(fifteen_linear_conflict, linear_conflict_result);
+        add(fifteen_walking_distance, walking_distance_result);
+    }
+    print("15 / ida_star (linear conflict)", fifteen_linear_conflict, fifteen_count);
+    print("15 / ida_star (walking distance)", fifteen_walking_distance, fifteen_count);
+
+    Result twenty_four;
+    for (int i = 0; i < twenty_four_count; ++i) {
+        const sliding_puzzle::TwentyFourPuzzleState instance(engine, twenty_four_moves);
+        const auto result = solve_ida_star(instance);
+        if (result.length > twenty_four_moves) {
+            std::cerr << "Error: solution is longer than the scramble" << std::endl;
+            return 1;
+        }
+        add(twenty_four, result);
+    }
+    print("24 / ida_star (linear conflict)", twenty_four, twenty_four_count);
+    return 0;
+}
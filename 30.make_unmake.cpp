@@ -0,0 +1,240 @@
+/*
+状態のコピーと make / unmake (step と undo) の比較
+同じ探索を, 子の節点ごとに状態をコピーする版と, 1 つの状態を step / undo で書き換える版で行い, 結果が一致することを確かめて速度を比べる
+  オセロ    : アルファベータ探索 (深さ固定). undo には返したコマの位置 (UndoInfo) を使う
+  三目並べ  : すべての節点を訪問する深さ優先探索
+  15 パズル : 反復深化 A* 探索 (書き換える版は utils/ida_star)
+書き換える版は状態を参照で受け取るので, 並列に探索するときはスレッドごとに状態を 1 つ持てばよい
+使い方: make_unmake [オセロの探索深さ] [オセロの局面数] [15 パズルの問題数]
+*/
+
+#include <chrono>
+#include <climits>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "games/fifteen_puzzle.hpp"
+#include "games/othello.hpp"
+#include "games/tic_tac_toe.hpp"
+#include "utils/ida_star.hpp"
+
+using othello::score::INF;
+using othello::score::ScoreType;
+
+static int64_t node_count = 0;
+
+namespace copy_search {
+
+ScoreType alpha_beta_score(const othello::State& state, ScoreType alpha, const ScoreType beta, const int depth) {
+    ++node_count;
+    if (state.is_done() || depth == 0) {
+        return state.get_score();
+    }
+    auto legal_actions = state.legal_actions();
+    if (legal_actions.empty()) {
+        legal_actions.emplace_back(othello::NO_POS);
+    }
+    for (const auto action : legal_actions) {
+        othello::State next_state = state;
+        next_state.step(action);
+        const ScoreType score = -alpha_beta_score(next_state, -beta, -alpha, depth - 1);
+        if (score > alpha) {
+            alpha = score;
+        }
+        if (alpha >= beta) {
+            return alpha;
+        }
+    }
+    return alpha;
+}
+
+void dfs(const tic_tac_toe::State& state) {
+    ++node_count;
+    if (state.is_done()) {
+        return;
+    }
+    for (const auto action : state.legal_actions()) {
+        tic_tac_toe::State next_state = state;
+        next_state.step(action);
+        dfs(next_state);
+    }
+}
+
+// utils/ida_star と同じ順に節点を訪問する
+template <class State>
+bool ida_star_search(const State& state, const int threshold, int& next_threshold, const int pre_action) {
+    ++node_count;
+    const int f_cost = state.get_f_cost();
+    if (f_cost > threshold) {
+        next_threshold = std::min(next_threshold, f_cost);
+        return false;
+    }
+    if (state.is_done()) {
+        return true;
+    }
+    for (int action = 0; action < State::ACTION_COUNT; ++action) {
+        if ((pre_action >= 0 && action == State::inverse_action(pre_action)) || !state.is_legal_action(action)) {
+            continue;
+        }
+        State next_state = state;
+        next_state.step(action);
+        if (ida_star_search(next_state, threshold, next_threshold, action)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <class State>
+int ida_star(const State& state) {
+    for (int threshold = state.get_f_cost(); ; ) {
+        int next_threshold = INT_MAX;
+        if (ida_star_search(state, threshold, next_threshold, -1)) {
+            return threshold;
+        }
+        threshold = next_threshold;
+    }
+}
+
+} // namespace copy_search
+
+namespace in_place_search {
+
+ScoreType alpha_beta_score(othello::State& state, ScoreType alpha, const ScoreType beta, const int depth) {
+    ++node_count;
+    if (state.is_done() || depth == 0) {
+        return state.get_score();
+    }
+    auto legal_actions = state.legal_actions();
+    if (legal_actions.empty()) {
+        legal_actions.emplace_back(othello::NO_POS);
+    }
+    for (const auto action : legal_actions) {
+        othello::State::UndoInfo undo_info;
+        state.step(action, undo_info);
+        const ScoreType score = -alpha_beta_score(state, -beta, -alpha, depth - 1);
+        state.undo(action, undo_info);
+        if (score > alpha) {
+            alpha = score;
+        }
+        if (alpha >= beta) {
+            return alpha;
+        }
+    }
+    return alpha;
+}
+
+void dfs(tic_tac_toe::State& state) {
+    ++node_count;
+    if (state.is_done()) {
+        return;
+    }
+    for (const auto action : state.legal_actions()) {
+        tic_tac_toe::State::UndoInfo undo_info;
+        state.step(action, undo_info);
+        dfs(state);
+        state.undo(action, undo_info);
+    }
+}
+
+} // namespace in_place_search
+
+// function を呼んで, 訪問節点数と時間を返す
+template <class Function>
+std::pair<int64_t, double> measure(Function function) {
+    node_count = 0;
+    const auto start_time = std::chrono::high_resolution_clock::now();
+    function();
+    return {node_count, std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count()};
+}
+
+void print(const std::string& name, const std::pair<int64_t, double>& copy_result, const std::pair<int64_t, double>& in_place_result) {
+    std::cout << name << '\t' << copy_result.first << '\t' << copy_result.first / copy_result.second << '\t' << in_place_result.first / in_place_result.second << '\t'
+              << copy_result.second / in_place_result.second << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    const int depth = argc > 1 ? std::stoi(argv[1]) : 7;
+    const int position_count = argc > 2 ? std::stoi(argv[2]) : 10;
+    const int instance_count = argc > 3 ? std::stoi(argv[3]) : 3;
+    std::cout << "search\tnodes\tcopy nodes/sec\tmake/unmake nodes/sec\tspeedup" << std::endl;
+
+    // ランダムに 10 手進めた局面
+    std::mt19937 engine(1);
+    std::vector<othello::State> positions;
+    while (static_cast<int>(positions.size()) < position_count) {
+        othello::State state;
+        for (int t = 0; t < 10 && !state.is_done(); ++t) {
+            auto legal_actions = state.legal_actions();
+            state.step(legal_actions.empty() ? othello::NO_POS : legal_actions[engine() % legal_actions.size()]);
+        }
+        if (!state.is_done()) {
+            positions.emplace_back(state);
+        }
+    }
+    std::vector<ScoreType> copy_scores;
+    const auto othello_copy = measure([&] {
+        for (const auto& position : positions) {
+            copy_scores.emplace_back(copy_search::alpha_beta_score(position, -INF, INF, depth));
+        }
+    });
+    std::vector<ScoreType> in_place_scores;
+    const auto othello_in_place = measure([&] {
+        for (auto position : positions) {
+            in_place_scores.emplace_back(in_place_search::alpha_beta_score(position, -INF, INF, depth));
+        }
+    });
+    if (copy_scores != in_place_scores || othello_copy.first != othello_in_place.first) {
+        std::cerr << "Error: alpha-beta results differ" << std::endl;
+        return 1;
+    }
+    print("othello alpha_beta (depth " + std::to_string(depth) + ")", othello_copy, othello_in_place);
+
+    const auto tic_tac_toe_copy = measure([] {
+        for (int i = 0; i < 20; ++i) {
+            copy_search::dfs(tic_tac_toe::State());
+        }
+    });
+    const auto tic_tac_toe_in_place = measure([] {
+        for (int i = 0; i < 20; ++i) {
+            tic_tac_toe::State state;
+            in_place_search::dfs(state);
+        }
+    });
+    if (tic_tac_toe_copy.first != tic_tac_toe_in_place.first) {
+        std::cerr << "Error: DFS node counts differ" << std::endl;
+        return 1;
+    }
+    print("tic_tac_toe dfs (x20)", tic_tac_toe_copy, tic_tac_toe_in_place);
+
+    using FifteenState = fifteen_puzzle::BasicFifteenPuzzleState<fifteen_puzzle::heuristic::LinearConflict>;
+    std::mt19937_64 puzzle_engine(1);
+    std::vector<FifteenState> instances;
+    for (int i = 0; i < instance_count; ++i) {
+        instances.emplace_back(fifteen_puzzle::random_board(puzzle_engine));
+    }
+    std::vector<int> copy_lengths;
+    const auto fifteen_copy = measure([&] {
+        for (const auto& instance : instances) {
+            copy_lengths.emplace_back(copy_search::ida_star(instance));
+        }
+    });
+    std::vector<int> in_place_lengths;
+    int64_t in_place_node_count = 0;
+    const auto fifteen_in_place = measure([&] {
+        for (const auto& instance : instances) {
+            ida_star::Solver<FifteenState> solver;
+            in_place_lengths.emplace_back(solver.solve(instance).size());
+            in_place_node_count += solver.total_node_count();
+        }
+    });
+    // utils/ida_star は最後の閾値の探索を解が見つかった時点で打ち切るので, 節点数は copy_search と一致する
+    if (copy_lengths != in_place_lengths || fifteen_copy.first != in_place_node_count) {
+        std::cerr << "Error: IDA* results differ" << std::endl;
+        return 1;
+    }
+    print("fifteen_puzzle ida_star", fifteen_copy, {in_place_node_count, fifteen_in_place.second});
+    return 0;
+}
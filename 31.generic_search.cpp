@@ -0,0 +1,476 @@
+/*
+汎用の探索 (utils/generic_search) とゲームごとの実装の比較
+ゲームごとの実装は 02.alpha_beta, 07.mcts, 09.and_or, 10.transposition_table と同じもの (節点数を数えるところだけ追加)
+  オセロ    : アルファベータ探索 (行動と節点数が一致することを確かめる), MCTS (プレイアウト回数あたりの時間)
+  三目並べ  : AND/OR 木探索 (到達可能なすべての非終端局面で行動と節点数が一致することを確かめる)
+              トランスポジションテーブル付き (行動が一致することを確かめる)
+              ランダムプレイヤー同士の対戦 (std::function の play::Player と, 型消去しないプレイヤー)
+汎用の探索は状態が undo を持てば 1 つの状態を書き換えて探索するので, その差も速度に含まれる
+使い方: generic_search [オセロの探索深さ] [オセロの局面数] [MCTS のプレイアウト回数] [対戦回数]
+*/
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "games/fifteen_puzzle.hpp"
+#include "games/othello.hpp"
+#include "games/play.hpp"
+#include "games/tic_tac_toe.hpp"
+#include "utils/generic_search.hpp"
+#include "utils/transposition_table.hpp"
+
+using othello::score::INF;
+using othello::score::ScoreType;
+
+using FifteenState = fifteen_puzzle::BasicFifteenPuzzleState<fifteen_puzzle::heuristic::LinearConflict>;
+
+static_assert(generic_search::GameState<othello::State> && generic_search::UndoableState<othello::State> && generic_search::HashableState<othello::State>);
+static_assert(generic_search::GameState<tic_tac_toe::State> && generic_search::UndoableState<tic_tac_toe::State> && generic_search::HashableState<tic_tac_toe::State>);
+static_assert(generic_search::PuzzleState<FifteenState> && generic_search::InPlacePuzzleState<FifteenState>);
+static_assert(!generic_search::GameState<FifteenState>);
+
+static int64_t node_count = 0;
+
+namespace per_file {
+
+ScoreType alpha_beta_score(const othello::State& state, ScoreType alpha, const ScoreType beta, const int depth) {
+    ++node_count;
+    if (state.is_done() || depth == 0) {
+        return state.get_score();
+    }
+    auto legal_actions = state.legal_actions();
+    if (legal_actions.empty()) {
+        legal_actions.emplace_back(othello::NO_POS);
+    }
+    for (const auto action : legal_actions) {
+        othello::State next_state = state;
+        next_state.step(action);
+        ScoreType score = -alpha_beta_score(next_state, -beta, -alpha, depth - 1);
+        if (score > alpha) {
+            alpha = score;
+        }
+        if (alpha >= beta) {
+            return alpha;
+        }
+    }
+    return alpha;
+}
+
+othello::Action alpha_beta_action(const othello::State& state, const int depth) {
+    othello::Action best_action = othello::NO_POS;
+    ScoreType alpha = -INF;
+    ScoreType beta = INF;
+    auto legal_actions = state.legal_actions();
+    for (const auto action : legal_actions) {
+        othello::State next_state = state;
+        next_state.step(action);
+        ScoreType score = -alpha_beta_score(next_state, -beta, -alpha, depth);
+        if (score > alpha) {
+            best_action = action;
+            alpha = score;
+        }
+    }
+    return best_action;
+}
+
+int playout(othello::State& state) {
+    switch (state.get_winning_status()) {
+    case WinningStatus::WIN:
+        return 1;
+    case WinningStatus::LOSE:
+    case WinningStatus::DRAW:
+        return 0;
+    default:
+        state.step(othello::random_action(state));
+        return 1 - playout(state);
+    }
+}
+
+class Node {
+public:
+    std::vector<Node> child_nodes;
+    int count;
+
+    explicit Node(const othello::State& state) : count(0), state_(state), win_(0) {}
+
+    void expand() {
+        auto legal_actions = state_.legal_actions();
+        child_nodes.clear();
+        for (const auto action : legal_actions) {
+            child_nodes.emplace_back(state_);
+            child_nodes.back().state_.step(action);
+        }
+    }
+
+    int evaluate() {
+        int value = 0;
+        if (state_.is_done()) {
+            switch (state_.get_winning_status()) {
+            case WinningStatus::WIN:
+                value = 1;
+                break;
+            default:
+                break;
+            }
+        } else if (child_nodes.empty()) {
+            othello::State state_copy = state_;
+            value = playout(state_copy);
+
+            if (count == EXPAND_THRESHOLD) {
+                expand();
+            }
+        } else {
+            value = 1 - next_child_node().evaluate();
+        }
+        win_ += value;
+        ++count;
+        return value;
+    }
+
+    Node& next_child_node() {
+        for (auto& child_node : child_nodes) {
+            if (child_node.count == 0) {
+                return child_node;
+            }
+        }
+        int t = 0;
+        for (const auto& child_node : child_nodes) {
+            t += child_node.count;
+        }
+        double best_value = -INF;
+        int best_action_idx = -1;
+        int action_size = child_nodes.size();
+
+        for (int action_idx = 0; action_idx < action_size; ++action_idx) {
+            const auto& child_node = child_nodes[action_idx];
+            static constexpr double C = 1.;
+            double ucb1_value = 1 - static_cast<double>(child_node.win_) / child_node.count + C * std::sqrt(std::log(t) / child_node.count);
+            if (ucb1_value > best_value) {
+                best_action_idx = action_idx;
+                best_value = ucb1_value;
+            }
+        }
+        return child_nodes[best_action_idx];
+    }
+
+private:
+    static constexpr int EXPAND_THRESHOLD = 10;
+
+    othello::State state_;
+    int win_;
+};
+
+othello::Action mcts_action(const othello::State& state, int playout_number) {
+    auto legal_actions = state.legal_actions();
+    int action_size = legal_actions.size();
+    if (!action_size) {
+        return othello::NO_POS;
+    }
+    Node root_node(state);
+    root_node.expand();
+    for (int t = 0; t < playout_number; ++t) {
+        root_node.evaluate();
+    }
+    int best_action_idx = -1;
+    int best_action_count = -1;
+    for (int action_idx = 0; action_idx < action_size; ++action_idx) {
+        if (int n = root_node.child_nodes[action_idx].count; n > best_action_count) {
+            best_action_idx = action_idx;
+            best_action_count = n;
+        }
+    }
+    return legal_actions[best_action_idx];
+}
+
+int or_score(const tic_tac_toe::State& state);
+int and_score(const tic_tac_toe::State& state);
+
+int and_score(const tic_tac_toe::State& state) {
+    ++node_count;
+    switch (state.get_winning_status()) {
+    case WinningStatus::LOSE:
+        return 1;
+    case WinningStatus::WIN:
+    case WinningStatus::DRAW:
+        return 0;
+    default:
+        auto legal_actions = state.legal_actions();
+        for (const auto action : legal_actions) {
+            tic_tac_toe::State next_state = state;
+            next_state.step(action);
+            if (!or_score(next_state)) {
+                return 0;
+            }
+        }
+        return 1;
+    }
+}
+
+int or_score(const tic_tac_toe::State& state) {
+    ++node_count;
+    switch (state.get_winning_status()) {
+    case WinningStatus::WIN:
+        return 1;
+    case WinningStatus::LOSE:
+    case WinningStatus::DRAW:
+        return 0;
+    default:
+        auto legal_actions = state.legal_actions();
+        for (const auto action : legal_actions) {
+            tic_tac_toe::State next_state = state;
+            next_state.step(action);
+            if (and_score(next_state)) {
+                return 1;
+            }
+        }
+        return 0;
+    }
+}
+
+tic_tac_toe::Action and_or_action(const tic_tac_toe::State& state) {
+    auto legal_actions = state.legal_actions();
+    for (const auto action : legal_actions) {
+        tic_tac_toe::State next_state = state;
+        next_state.step(action);
+        if (and_score(next_state)) {
+            return action;
+        }
+    }
+    return legal_actions[0];
+}
+
+TranspositionTable<int> state_values(1);
+
+int table_or_score(const tic_tac_toe::State& state);
+int table_and_score(const tic_tac_toe::State& state);
+
+int table_and_score(const tic_tac_toe::State& state) {
+    ++node_count;
+    int state_value = 1;
+    switch (state.get_winning_status()) {
+    case WinningStatus::LOSE:
+        break;
+    case WinningStatus::WIN:
+    case WinningStatus::DRAW:
+        state_value = 0;
+        break;
+    default:
+        auto legal_actions = state.legal_actions();
+        for (const auto action : legal_actions) {
+            tic_tac_toe::State next_state = state;
+            next_state.step(action);
+            if (const auto* value = state_values.find(next_state.hash_value); value != nullptr) {
+                state_value &= *value;
+            } else {
+                state_value &= table_or_score(next_state);
+            }
+            if (!state_value) {
+                break;
+            }
+        }
+        break;
+    }
+    state_values.store(state.hash_value, state_value);
+    return state_value;
+}
+
+int table_or_score(const tic_tac_toe::State& state) {
+    ++node_count;
+    int state_value = 0;
+    switch (state.get_winning_status()) {
+    case WinningStatus::WIN:
+        state_value = 1;
+        break;
+    case WinningStatus::LOSE:
+    case WinningStatus::DRAW:
+        break;
+    default:
+        auto legal_actions = state.legal_actions();
+        for (const auto action : legal_actions) {
+            tic_tac_toe::State next_state = state;
+            next_state.step(action);
+            if (const auto* value = state_values.find(next_state.hash_value); value != nullptr) {
+                state_value |= *value;
+            } else {
+                state_value |= table_and_score(next_state);
+            }
+            if (state_value) {
+                break;
+            }
+        }
+        break;
+    }
+    state_values.store(state.hash_value, state_value);
+    return state_value;
+}
+
+tic_tac_toe::Action table_and_or_action(const tic_tac_toe::State& state) {
+    state_values.clear();
+    auto legal_actions = state.legal_actions();
+    for (const auto action : legal_actions) {
+        tic_tac_toe::State next_state = state;
+        next_state.step(action);
+        if (table_and_score(next_state)) {
+            return action;
+        }
+    }
+    return legal_actions[0];
+}
+
+} // namespace per_file
+
+// function を呼んで, 時間を返す
+template <class Function>
+double measure(Function function) {
+    const auto start_time = std::chrono::high_resolution_clock::now();
+    function();
+    return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+}
+
+void print(const std::string& name, const int64_t count, const double per_file_seconds, const double generic_seconds) {
+    std::cout << name << '\t' << count << '\t' << count / per_file_seconds << '\t' << count / generic_seconds << '\t' << per_file_seconds / generic_seconds << std::endl;
+}
+
+// 三目並べの到達可能な非終端局面をすべて集める
+void collect_positions(const tic_tac_toe::State& state, std::unordered_set<uint64_t>& visited, std::vector<tic_tac_toe::State>& positions) {
+    if (state.is_done() || !visited.insert(state.hash_value).second) {
+        return;
+    }
+    positions.emplace_back(state);
+    for (const auto action : state.legal_actions()) {
+        tic_tac_toe::State next_state = state;
+        next_state.step(action);
+        collect_positions(next_state, visited, positions);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const int depth = argc > 1 ? std::stoi(argv[1]) : 5;
+    const int position_count = argc > 2 ? std::stoi(argv[2]) : 20;
+    const int playout_number = argc > 3 ? std::stoi(argv[3]) : 20000;
+    const int game_number = argc > 4 ? std::stoi(argv[4]) : 200000;
+    std::cout << "search\tcount\tper-file count/sec\tgeneric count/sec\tspeedup" << std::endl;
+
+    // ランダムに 10 手進めた局面
+    std::mt19937 engine(1);
+    std::vector<othello::State> positions;
+    while (static_cast<int>(positions.size()) < position_count) {
+        othello::State state;
+        for (int t = 0; t < 10 && !state.is_done(); ++t) {
+            auto legal_actions = state.legal_actions();
+            state.step(legal_actions.empty() ? othello::NO_POS : legal_actions[engine() % legal_actions.size()]);
+        }
+        if (!state.is_done()) {
+            positions.emplace_back(state);
+        }
+    }
+
+    std::vector<othello::Action> per_file_actions;
+    node_count = 0;
+    const double alpha_beta_per_file = measure([&] {
+        for (const auto& position : positions) {
+            per_file_actions.emplace_back(per_file::alpha_beta_action(position, depth));
+        }
+    });
+    std::vector<othello::Action> generic_actions;
+    generic_search::AlphaBeta<othello::State> alpha_beta;
+    const double alpha_beta_generic = measure([&] {
+        for (const auto& position : positions) {
+            generic_actions.emplace_back(alpha_beta.best_action(position, depth));
+        }
+    });
+    if (per_file_actions != generic_actions || node_count != alpha_beta.node_count()) {
+        std::cerr << "Error: alpha-beta results differ" << std::endl;
+        return 1;
+    }
+    print("othello alpha_beta (depth " + std::to_string(depth) + ")", node_count, alpha_beta_per_file, alpha_beta_generic);
+
+    const double mcts_per_file = measure([&] {
+        for (const auto& position : positions) {
+            per_file::mcts_action(position, playout_number);
+        }
+    });
+    generic_search::Mcts<othello::State> mcts(generic_search::RandomPlayout(1));
+    const double mcts_generic = measure([&] {
+        for (const auto& position : positions) {
+            mcts.best_action(position, playout_number);
+        }
+    });
+    print("othello mcts (playouts)", mcts.playout_count(), mcts_per_file, mcts_generic);
+
+    std::unordered_set<uint64_t> visited;
+    std::vector<tic_tac_toe::State> tic_tac_toe_positions;
+    collect_positions(tic_tac_toe::State(), visited, tic_tac_toe_positions);
+
+    std::vector<tic_tac_toe::Action> per_file_and_or_actions;
+    node_count = 0;
+    const double and_or_per_file = measure([&] {
+        for (const auto& position : tic_tac_toe_positions) {
+            per_file_and_or_actions.emplace_back(per_file::and_or_action(position));
+        }
+    });
+    std::vector<tic_tac_toe::Action> generic_and_or_actions;
+    generic_search::AndOr<tic_tac_toe::State> and_or;
+    const double and_or_generic = measure([&] {
+        for (const auto& position : tic_tac_toe_positions) {
+            generic_and_or_actions.emplace_back(and_or.best_action(position));
+        }
+    });
+    if (per_file_and_or_actions != generic_and_or_actions || node_count != and_or.node_count()) {
+        std::cerr << "Error: AND/OR results differ" << std::endl;
+        return 1;
+    }
+    print("tic_tac_toe and_or (" + std::to_string(tic_tac_toe_positions.size()) + " positions)", node_count, and_or_per_file, and_or_generic);
+
+    per_file_and_or_actions.clear();
+    node_count = 0;
+    const double table_per_file = measure([&] {
+        for (const auto& position : tic_tac_toe_positions) {
+            per_file_and_or_actions.emplace_back(per_file::table_and_or_action(position));
+        }
+    });
+    generic_and_or_actions.clear();
+    generic_search::AndOr<tic_tac_toe::State, true> table_and_or;
+    const double table_generic = measure([&] {
+        for (const auto& position : tic_tac_toe_positions) {
+            generic_and_or_actions.emplace_back(table_and_or.best_action(position));
+        }
+    });
+    // 表を引く位置が異なるので節点数は一致しない. 時間は局面あたり
+    if (per_file_and_or_actions != generic_and_or_actions) {
+        std::cerr << "Error: AND/OR with table results differ" << std::endl;
+        return 1;
+    }
+    print("tic_tac_toe and_or with table (positions)", tic_tac_toe_positions.size(), table_per_file, table_generic);
+
+    // 同じ種の乱数で同じ対局を再現し, プレイヤーの呼び出し方だけを変える
+    std::mt19937 engine0(1), engine1(2);
+    auto random_player0 = [&](const tic_tac_toe::State& state) { return generic_search::random_action(state, engine0); };
+    auto random_player1 = [&](const tic_tac_toe::State& state) { return generic_search::random_action(state, engine1); };
+    std::array<int, 3> function_results = {}, static_results = {};
+    const std::array<play::Player<tic_tac_toe::State, tic_tac_toe::Action>, 2> players = {random_player0, random_player1};
+    const double function_seconds = measure([&] {
+        for (int t = 0; t < game_number; ++t) {
+            ++function_results[static_cast<int>(play::play_game(players, t & 1, false).first) - 1];
+        }
+    });
+    engine0.seed(1);
+    engine1.seed(2);
+    const double static_seconds = measure([&] {
+        for (int t = 0; t < game_number; ++t) {
+            ++static_results[static_cast<int>(play::play_game<tic_tac_toe::State>(random_player0, random_player1, t & 1, false).first) - 1];
+        }
+    });
+    if (function_results != static_results) {
+        std::cerr << "Error: game results differ" << std::endl;
+        return 1;
+    }
+    print("tic_tac_toe play_game (games)", game_number, function_seconds, static_seconds);
+    return 0;
+}
@@ -0,0 +1,88 @@
+/*
+並列の対戦と SPRT による打ち切り
+オセロで MCTS (utils/generic_search) とアルファベータ探索を対戦させ, 強さの差が SPRT で決まった時点で打ち切る
+同じ局面ばかりにならないよう, 両プレイヤーとも最初の数手はランダムに打つ. 乱数はすべてゲームごとの種から作る
+指定したスレッド数と 1 スレッドで同じ対戦を行い, 集計結果が一致することを確かめて時間を比べる
+使い方: match_runner [スレッド数] [最大ゲーム数] [MCTS のプレイアウト回数] [アルファベータ探索の深さ] [種]
+*/
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+
+#include "games/match_runner.hpp"
+#include "games/othello.hpp"
+#include "utils/generic_search.hpp"
+
+using State = othello::State;
+using Action = othello::Action;
+
+// 最初にランダムに打つ手数
+static constexpr unsigned int RANDOM_OPENING_TURN = 4;
+
+struct MctsPlayer {
+    std::mt19937 engine;
+    generic_search::Mcts<State> mcts;
+    int playout_number;
+
+    MctsPlayer(const uint64_t seed, const int playout_number) : engine(seed), mcts(generic_search::RandomPlayout(seed >> 32)), playout_number(playout_number) {}
+
+    Action operator()(const State& state) {
+        if (state.turn < RANDOM_OPENING_TURN) {
+            return othello::random_action(state, engine);
+        }
+        return mcts.best_action(state, playout_number);
+    }
+};
+
+struct AlphaBetaPlayer {
+    std::mt19937 engine;
+    generic_search::AlphaBeta<State> alpha_beta;
+    int depth;
+
+    AlphaBetaPlayer(const uint64_t seed, const int depth) : engine(seed), depth(depth) {}
+
+    Action operator()(const State& state) {
+        if (state.turn < RANDOM_OPENING_TURN) {
+            return othello::random_action(state, engine);
+        }
+        return alpha_beta.best_action(state, depth);
+    }
+};
+
+int main(int argc, char* argv[]) {
+    const int thread_count = argc > 1 ? std::stoi(argv[1]) : std::thread::hardware_concurrency();
+    const int game_number = argc > 2 ? std::stoi(argv[2]) : 1000;
+    const int playout_number = argc > 3 ? std::stoi(argv[3]) : 1000;
+    const int depth = argc > 4 ? std::stoi(argv[4]) : 2;
+    const uint64_t seed = argc > 5 ? std::stoull(argv[5]) : 0;
+
+    play::MatchOptions options;
+    options.game_number = game_number;
+    options.seed = seed;
+    options.sprt = play::SprtParameters{0., 50., 0.05, 0.05};
+    const auto make_mcts_player = [playout_number](const uint64_t player_seed) { return MctsPlayer(player_seed, playout_number); };
+    const auto make_alpha_beta_player = [depth](const uint64_t player_seed) { return AlphaBetaPlayer(player_seed, depth); };
+
+    std::cout << "mcts (" << playout_number << " playouts) vs alpha_beta (depth " << depth << ")" << std::endl;
+    options.thread_count = thread_count;
+    auto start_time = std::chrono::high_resolution_clock::now();
+    const auto result = play::run_match<State>(make_mcts_player, make_alpha_beta_player, options);
+    const double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+    play::print_match_result(result, options);
+
+    options.thread_count = 1;
+    start_time = std::chrono::high_resolution_clock::now();
+    const auto sequential_result = play::run_match<State>(make_mcts_player, make_alpha_beta_player, options);
+    const double sequential_seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+    if (result.win != sequential_result.win || result.lose != sequential_result.lose || result.draw != sequential_result.draw) {
+        std::cerr << "Error: results differ between " << thread_count << " threads and 1 thread" << std::endl;
+        return 1;
+    }
+    std::cout << "Time (" << thread_count << " threads)\t" << seconds << " s" << std::endl;
+    std::cout << "Time (1 thread)\t" << sequential_seconds << " s" << std::endl;
+    std::cout << "Speedup\t" << sequential_seconds / seconds << std::endl;
+    return 0;
+}
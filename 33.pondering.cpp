@@ -0,0 +1,57 @@
+/*
+ポンダリング (相手の手番の間も探索を続ける)
+オセロで, 1 手の思考時間が同じ MCTS 同士を対戦させる
+  ponder    : ポンダリングする MCTS (utils/pondering) とポンダリングしない MCTS
+  no ponder : ポンダリングしない MCTS 同士 (基準)
+ポンダーヒット率 (相手の手がポンダリング中に最も訪問した手と一致した割合), ポンダリングしていた時間,
+実際の手の部分木に費やした分 (次の手の探索に上乗せされる実質的な思考時間), 手を決めたときのルートの訪問回数を出力する
+ポンダリングのスレッドは相手の探索と並行して動くので, コアが 1 つだと相手の探索時間を奪う
+使い方: pondering [1 手の思考時間 (ミリ秒)] [対戦回数] [種]
+*/
+
+#include <iostream>
+#include <string>
+
+#include "games/othello.hpp"
+#include "games/play.hpp"
+#include "utils/generic_search.hpp"
+#include "utils/pondering.hpp"
+
+using State = othello::State;
+using Player = pondering::MctsPlayer<State>;
+
+// game_number 回対戦させて, players[0] から見た勝敗と両プレイヤーの記録を出力する
+void run(const std::string& name, const int64_t think_time_ms, const bool is_pondering, const int game_number, const uint32_t seed) {
+    int results[3] = {};
+    pondering::PonderStats stats[2];
+    for (int t = 0; t < game_number; ++t) {
+        Player player0(think_time_ms, is_pondering, generic_search::RandomPlayout(seed + 2 * t));
+        Player player1(think_time_ms, false, generic_search::RandomPlayout(seed + 2 * t + 1));
+        switch (play::play_game<State>(player0, player1, t & 1, false).first) {
+        case WinningStatus::WIN:
+            ++results[0];
+            break;
+        case WinningStatus::LOSE:
+            ++results[1];
+            break;
+        default:
+            ++results[2];
+            break;
+        }
+        stats[0] += player0.stats();
+        stats[1] += player1.stats();
+    }
+    std::cout << name << '\t' << results[0] << '\t' << results[1] << '\t' << results[2] << '\t' << (results[0] + 0.5 * results[2]) / game_number << '\t'
+              << stats[0].hit_rate() << '\t' << stats[0].ponder_seconds / stats[0].move_count << '\t' << stats[0].extra_seconds_per_move() << '\t'
+              << static_cast<double>(stats[0].root_count) / stats[0].move_count << '\t' << static_cast<double>(stats[1].root_count) / stats[1].move_count << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    const int64_t think_time_ms = argc > 1 ? std::stoll(argv[1]) : 20;
+    const int game_number = argc > 2 ? std::stoi(argv[2]) : 20;
+    const uint32_t seed = argc > 3 ? std::stoul(argv[3]) : 0;
+    std::cout << "players\twin\tlose\tdraw\tscore\tponder hit rate\tponder s/move\textra s/move\troot visits/move\topponent root visits/move" << std::endl;
+    run("ponder", think_time_ms, true, game_number, seed);
+    run("no ponder", think_time_ms, false, game_number, seed);
+    return 0;
+}
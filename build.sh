@@ -18,11 +18,13 @@ play="games/play.cpp"
 othello="games/othello.cpp"
 tic_tac_toe="games/tic_tac_toe.cpp"
 fifteen_puzzle="games/fifteen_puzzle.cpp"
+fifteen_puzzle_pdb="games/fifteen_puzzle_pdb.cpp"
 time_keeper="utils/time_keeper.cpp"
+probcut="utils/probcut.cpp"
 
 # args に "all" が含まれるならすべてコンパイルする
 if [[ "${args[*]}" == *"all"* ]]; then
-    args=("01" "02" "03" "04" "05" "06" "07" "08" "09" "10" "11" "12")
+    args=("01" "02" "03" "04" "05" "06" "07" "08" "09" "10" "11" "12" "13" "14" "15" "16" "17" "18" "19" "20" "21" "22" "23" "24" "25" "26" "27" "28" "29" "30" "31" "32" "33")
 fi
 
 # 実行ファイルを生成するディレクトリ
@@ -36,18 +38,39 @@ fi
 # コンパイル
 for arg in "${args[@]}"; do
     case $arg in
-        01) $compiler $options -o $build_dir/mini_max $play $othello 01.mini_max.cpp ;;
-        02) $compiler $options -o $build_dir/alpha_beta $play $othello 02.alpha_beta.cpp ;;
+        01) $compiler $options -pthread -o $build_dir/mini_max $play $othello 01.mini_max.cpp ;;
+        02) $compiler $options -pthread -o $build_dir/alpha_beta $play $othello 02.alpha_beta.cpp ;;
         03) $compiler $options -o $build_dir/iterative_deeping $play $othello $time_keeper 03.iterative_deeping.cpp ;;
         04) $compiler $options -o $build_dir/evaluate_function $play $othello $time_keeper 04.evaluate_function.cpp ;;
-        05) $compiler $options -o $build_dir/primitive_montecalro $play $othello 05.primitive_montecalro.cpp ;;
-        06) $compiler $options -o $build_dir/uct $play $othello 06.uct.cpp ;;
-        07) $compiler $options -o $build_dir/mcts $play $othello 07.mcts.cpp ;;
+        05) $compiler $options -pthread -o $build_dir/primitive_montecalro $play $othello 05.primitive_montecalro.cpp ;;
+        06) $compiler $options -pthread -o $build_dir/uct $play $othello 06.uct.cpp ;;
+        07) $compiler $options -pthread -o $build_dir/mcts $play $othello 07.mcts.cpp ;;
         08) $compiler $options -o $build_dir/dfs $play $tic_tac_toe 08.dfs.cpp ;;
-        09) $compiler $options -o $build_dir/and_or $play $tic_tac_toe 09.and_or.cpp ;;
-        10) $compiler $options -o $build_dir/transposition_table $play $tic_tac_toe 10.transposition_table.cpp ;;
+        09) $compiler $options -pthread -o $build_dir/and_or $play $tic_tac_toe 09.and_or.cpp ;;
+        10) $compiler $options -pthread -o $build_dir/transposition_table $play $tic_tac_toe 10.transposition_table.cpp ;;
         11) $compiler $options -o $build_dir/a_star $play $fifteen_puzzle 11.a_star.cpp ;;
         12) $compiler $options -o $build_dir/ida_star $play $fifteen_puzzle 12.ida_star.cpp ;;
+        13) $compiler $options -o $build_dir/clock_management $play $othello 13.clock_management.cpp ;;
+        14) $compiler $options -o $build_dir/probcut_calibration $othello $probcut 14.probcut_calibration.cpp ;;
+        15) $compiler $options -o $build_dir/multi_probcut $play $othello $probcut 15.multi_probcut.cpp ;;
+        16) $compiler $options -o $build_dir/perfect_play_table $play $tic_tac_toe 16.perfect_play_table.cpp ;;
+        17) $compiler $options -o $build_dir/transposition_table_benchmark 17.transposition_table_benchmark.cpp ;;
+        18) $compiler $options -o $build_dir/df_pn $play $othello $tic_tac_toe 18.df_pn.cpp ;;
+        19) $compiler $options -o $build_dir/mnk_game 19.mnk_game.cpp ;;
+        20) $compiler $options -pthread -o $build_dir/parallel_dfs $tic_tac_toe 20.parallel_dfs.cpp ;;
+        21) $compiler $options -pthread -o $build_dir/pattern_database $fifteen_puzzle $fifteen_puzzle_pdb 21.pattern_database.cpp ;;
+        22) $compiler $options -o $build_dir/pattern_database_benchmark $fifteen_puzzle $fifteen_puzzle_pdb 22.pattern_database_benchmark.cpp ;;
+        23) $compiler $options -pthread -o $build_dir/parallel_ida_star $fifteen_puzzle 23.parallel_ida_star.cpp ;;
+        24) $compiler $options -pthread -o $build_dir/hda_star $fifteen_puzzle 24.hda_star.cpp ;;
+        25) $compiler $options -pthread -o $build_dir/batch_solver $fifteen_puzzle 25.batch_solver.cpp ;;
+        26) $compiler $options -o $build_dir/ara_star $fifteen_puzzle $time_keeper 26.ara_star.cpp ;;
+        27) $compiler $options -o $build_dir/bidirectional_search $fifteen_puzzle 27.bidirectional_search.cpp ;;
+        28) $compiler $options -pthread -o $build_dir/external_bfs 28.external_bfs.cpp ;;
+        29) $compiler $options -o $build_dir/sliding_puzzle $fifteen_puzzle 29.sliding_puzzle.cpp ;;
+        30) $compiler $options -o $build_dir/make_unmake $othello $tic_tac_toe $fifteen_puzzle 30.make_unmake.cpp ;;
+        31) $compiler $options -o $build_dir/generic_search $othello $tic_tac_toe $fifteen_puzzle 31.generic_search.cpp ;;
+        32) $compiler $options -pthread -o $build_dir/match_runner $othello 32.match_runner.cpp ;;
+        33) $compiler $options -pthread -o $build_dir/pondering $othello $time_keeper 33.pondering.cpp ;;
         *) echo "Invalid argument: $arg" ;;
     esac
 done
\ No newline at end of file
@@ -1,117 +1,145 @@
 #include "fifteen_puzzle.hpp"
 
-#include <iomanip>
+#include <fstream>
 #include <random>
+#include <sstream>
 
 namespace fifteen_puzzle {
 
-namespace zobrist_hashing {
-
-std::array<HashMap, 16> make_hash_map() {
-    static std::mt19937 engine{std::random_device()()};
-    std::array<HashMap, 16> hash_map;
-    for (int cell = 0; cell < 16; ++cell) {
-        for (int number = 1; number <= 15; ++number) {
-            hash_map[number][cell] = engine();
+namespace heuristic {
+
+const WalkingDistanceTable& walking_distance_table() {
+    static const WalkingDistanceTable table = [] {
+        // counts[行][終端の行] の 3 ビットを 16 個並べ, 上位に空白の行を置いたキー
+        auto encode = [](const std::array<std::array<int, 4>, 4>& counts, const int zero_row) {
+            uint64_t key = zero_row;
+            for (int row = 0; row < 4; ++row) {
+                for (int terminal_row = 0; terminal_row < 4; ++terminal_row) {
+                    key = (key << 3) | counts[row][terminal_row];
+                }
+            }
+            return key;
+        };
+        auto decode = [](uint64_t key, std::array<std::array<int, 4>, 4>& counts) {
+            for (int row = 3; row >= 0; --row) {
+                for (int terminal_row = 3; terminal_row >= 0; --terminal_row) {
+                    counts[row][terminal_row] = key & 7;
+                    key >>= 3;
+                }
+            }
+            return static_cast<int>(key);
+        };
+
+        WalkingDistanceTable table;
+        std::vector<uint64_t> keys;
+        std::array<std::array<int, 4>, 4> counts{};
+        for (int number = 1; number < 16; ++number) {
+            const int row = terminal_positions[number] >> 2;
+            ++counts[row][row];
         }
-    }
-    return hash_map;
+        keys.emplace_back(encode(counts, terminal_positions[0] >> 2));
+        table.indices[keys[0]] = 0;
+        table.distances.emplace_back(0);
+        // 終端状態から幅優先探索. 追加した順に keys を走査すればよい
+        for (std::size_t index = 0; index < keys.size(); ++index) {
+            const int zero_row = decode(keys[index], counts);
+            std::array<int32_t, 8> next_indices;
+            next_indices.fill(-1);
+            for (int direction = 0; direction < 2; ++direction) {
+                const int next_zero_row = zero_row + (direction ? 1 : -1);
+                if (next_zero_row < 0 || next_zero_row > 3) {
+                    continue;
+                }
+                for (int terminal_row = 0; terminal_row < 4; ++terminal_row) {
+                    if (counts[next_zero_row][terminal_row] == 0) {
+                        continue;
+                    }
+                    auto next_counts = counts;
+                    --next_counts[next_zero_row][terminal_row];
+                    ++next_counts[zero_row][terminal_row];
+                    const uint64_t key = encode(next_counts, next_zero_row);
+                    auto [it, is_inserted] = table.indices.emplace(key, static_cast<int32_t>(keys.size()));
+                    if (is_inserted) {
+                        keys.emplace_back(key);
+                        table.distances.emplace_back(table.distances[index] + 1);
+                    }
+                    next_indices[direction * 4 + terminal_row] = it->second;
+                }
+            }
+            table.next_indices.emplace_back(next_indices);
+        }
+        return table;
+    }();
+    return table;
 }
 
-} // namespace zobrist_hashing
+} // namespace heuristic
 
-std::array<zobrist_hashing::HashMap, 16> FifteenPuzzleState::hash_maps = zobrist_hashing::make_hash_map();
+Action random_action(const State& state) {
+    static std::mt19937 engine{std::random_device()()};
+    const auto legal_actions = state.legal_actions();
+    return legal_actions[engine() % legal_actions.size()];
+}
 
-// コマ配置の初期化
-// 終端状態から 100 回程度ランダムにスライドさせることで, 解くことのできる初期配置を生成する
-FifteenPuzzleState::FifteenPuzzleState() {
+std::array<int, 16> random_walk_board() {
+    static std::mt19937 engine{std::random_device()()};
+    std::array<int, 16> numbers;
     for (int number = 0; number < 16; ++number) {
-        positions_[number] = terminal_positions[number];
-        hash_value ^= hash_maps[number][positions_[number]];
+        numbers[terminal_positions[number]] = number;
     }
-
-    static std::mt19937 engine{std::random_device()()};
-    int T = 100 + engine() % 50;
+    State state(numbers);
+    const int T = 100 + engine() % 50;
     for (int t = 0; t < T; ++t) {
-        auto legal_actions = FifteenPuzzleState::legal_actions();
-        auto action = legal_actions[engine() % legal_actions.size()];
-        FifteenPuzzleState::step(action);
-    }
-
-    turn = 0;
-    g_cost = 0;
-    h_cost = compute_h_cost();
-}
-
-// action は 0: 左, 1: 右, 2: 上, 3: 下
-void FifteenPuzzleState::step(const int action) {
-    // action インデックスに対する移動量
-    static int move_amount[4] = {-1, 1, -4, 4};
-
-    int moved_zero = positions_[0] + move_amount[action];
-    // 空白を動かした先にあるコマの番号を探索
-    for (int number = 1; number <= 15; ++number) {
-        if (positions_[number] == moved_zero) {
-            hash_value ^= hash_maps[number][positions_[number]];
-            positions_[number] = positions_[0];
-            hash_value ^= hash_maps[number][positions_[number]];
-            break;
-        }
+        const auto legal_actions = state.legal_actions();
+        state.step(legal_actions[engine() % legal_actions.size()]);
     }
-    positions_[0] = moved_zero;
-
-    ++turn;
-    ++g_cost;
-    h_cost = compute_h_cost();
+    return state.board();
 }
 
-std::vector<int> FifteenPuzzleState::legal_actions() const {
-    std::vector<int> actions;
-    const auto [zero_h, zero_w] = get_coordinate(positions_[0]);
-    if (zero_w != 0) actions.emplace_back(0);
-    if (zero_w != 3) actions.emplace_back(1);
-    if (zero_h != 0) actions.emplace_back(2);
-    if (zero_h != 3) actions.emplace_back(3);
-    return actions;
+bool is_solvable(const std::array<int, 16>& numbers) {
+    return sliding_puzzle::is_solvable<4, 4>(numbers);
 }
 
-int FifteenPuzzleState::compute_h_cost() {
-    int sum_manhattan_distance = 0;
-    for (int number = 1; number <= 15; ++number) {
-        const auto [terminal_h, terminal_w] = get_coordinate(terminal_positions[number]);
-        const auto [current_h, current_w] = get_coordinate(positions_[number]);
-        sum_manhattan_distance += abs(terminal_h - current_h) + abs(terminal_w - current_w);
-    }
-    return sum_manhattan_distance;
+std::array<int, 16> random_board(std::mt19937_64& engine) {
+    return sliding_puzzle::random_board<4, 4>(engine);
 }
 
-// ゲーム状況の出力
-std::ostream& operator<<(std::ostream& os, const FifteenPuzzleState& state) {
-    os << "Turn\t" << state.turn << "\tg cost\t" << state.g_cost << "\th cost\t" << state.h_cost << "\tf cost\t" << state.get_f_cost() << '\n';
-    // numbers はインデックスがセル番号, 値がコマ番号
-    int numbers[16];
-    for (int number = 0; number < 16; ++number) {
-        numbers[state.positions_[number]] = number;
+bool load_boards(const std::string& path, std::vector<std::array<int, 16>>& boards) {
+    std::ifstream ifs(path);
+    if (!ifs) {
+        return false;
     }
-    for (int h = 0; h < 4; ++h) {
-        if (h) {
-            os << "-- + -- + -- + --" << '\n';
+    std::string line;
+    while (std::getline(ifs, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream iss(line);
+        std::vector<int> values;
+        for (int value; iss >> value; ) {
+            values.emplace_back(value);
+        }
+        if (values.empty()) {
+            continue;
         }
-        for (int w = 0; w < 4; ++w) {
-            if (w) {
-                os << " | ";
+        if (values.size() == 17) {
+            values.erase(values.begin());
+        }
+        if (values.size() != 16) {
+            return false;
+        }
+        std::array<int, 16> numbers;
+        int used = 0;
+        for (int cell = 0; cell < 16; ++cell) {
+            if (values[cell] < 0 || values[cell] > 15 || (used >> values[cell] & 1)) {
+                return false;
             }
-            os << std::setw(2) << numbers[h * 4 + w];
+            used |= 1 << values[cell];
+            numbers[15 - cell] = (16 - values[cell]) & 15;
         }
-        os << '\n';
+        boards.emplace_back(numbers);
     }
-    return os;
-}
-
-Action random_action(const State& state) {
-    static std::mt19937 engine{std::random_device()()};
-    const auto legal_actions = state.legal_actions();
-    return legal_actions[engine() % legal_actions.size()];
+    return true;
 }
 
 } // namespace fifteen_puzzle
\ No newline at end of file
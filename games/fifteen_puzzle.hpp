@@ -10,91 +10,195 @@
  13 | 14 | 15 |  0
 0 が空白
 セル番号は 左上から右へ 0, 1, ..., 15 とする
-h コストは, 各コマの終端までのマンハッタン距離の合計
+状態は games/sliding_puzzle の 4x4 の状態 (盤面は 4 ビット × 16 の 64 ビット整数) で, ここでは 4x4 専用の h コストの方針を足す
+h コストはテンプレート引数 Heuristic (heuristic 名前空間の方針) で選ぶ. 既定は各コマの終端までのマンハッタン距離の合計
+マンハッタン距離と linear conflict は sliding_puzzle の方針をそのまま使い, walking distance だけをここで実装する
+テンプレートを使用するために方針の実装はヘッダに書いている
 */
 
 #pragma once
 
 #include <array>
-#include <memory>
-#include <ostream>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "play.hpp"
+#include "sliding_puzzle.hpp"
 
 namespace fifteen_puzzle {
 
-namespace zobrist_hashing {
+using Geometry = sliding_puzzle::Geometry<4, 4>;
 
-using HashValue = uint64_t;
-using HashMap = HashValue[16];
-
-std::array<HashMap, 16> make_hash_map();
-
-} // namespace zobrist_hashing
+// 4 ビットごとに 16 個の値を詰めた盤面
+using PackedBoard = Geometry::Board;
+using HashValue = sliding_puzzle::HashValue;
 
 // インデックスがコマ番号, 値がセル番号
-constexpr int terminal_positions[16] = {15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14};
+inline constexpr const auto& terminal_positions = Geometry::terminal_positions;
 
 // cell 番号から座標 (行, 列) を取得
-inline std::pair<int, int> get_coordinate(int cell) {
-    int h = cell >> 2;  // cell / 4
-    int w = cell & 3;   // cell % 4
-    return {h, w};
+constexpr std::pair<int, int> get_coordinate(const int cell) {
+    return Geometry::get_coordinate(cell);
 }
 
-class FifteenPuzzleState {
-public:
-    unsigned int turn;
-    int g_cost;
-    int h_cost;
-
-    // 経路復元用に親節点へのポインタを記録
-    std::shared_ptr<FifteenPuzzleState> pre_state_ptr = nullptr;
-
-    zobrist_hashing::HashValue hash_value;
-
-    FifteenPuzzleState();
-
-    void step(const int action);
+// board の index 番目の 4 ビットを取得
+constexpr int get_nibble(const PackedBoard board, const int index) {
+    return Geometry::Pack::get(board, index);
+}
 
-    bool is_done() const;
+// h コストの方針 (sliding_puzzle::heuristic と同じ形で, 盤面の大きさ Geometry を受け取る)
+namespace heuristic {
 
-    std::vector<int> legal_actions() const;
+using sliding_puzzle::heuristic::Manhattan;
+using sliding_puzzle::heuristic::LinearConflict;
 
-    int compute_h_cost();
+// walking distance
+// 各行にある「終端の行が i のコマの数」の表と空白の行だけを区別し, コマを縦に動かす回数の最小値を事前に幅優先探索で求めておく
+// 列についても同じ表を使い, 縦と横の和を h コストとする
+template <class Geometry>
+struct WalkingDistance {
+    static_assert(Geometry::WIDTH == 4 && Geometry::HEIGHT == 4, "walking distance is implemented only for the 4x4 board");
 
-    int get_f_cost() const;
+    struct Data {
+        int32_t row_index;
+        int32_t column_index;
+    };
 
-    friend std::ostream& operator<<(std::ostream& os, const FifteenPuzzleState& state);
+    static int initialize(Data& data, const PackedBoard numbers, const PackedBoard positions);
 
-private:
-    static std::array<zobrist_hashing::HashMap, 16> hash_maps;
+    static int update(Data& data, const PackedBoard before, const PackedBoard after, const int number, const int from, const int to);
+};
 
-    // インデックスがコマ番号, 値がセル番号
-    int positions_[16];
+// walking distance の表
+// 抽象状態は, 各行の「終端の行が i のコマの数」(3 ビット × 16) と空白の行 (2 ビット) を詰めたキーで表す
+struct WalkingDistanceTable {
+    std::vector<uint8_t> distances;
+    // next_indices[添字][空白を上 (0) / 下 (1) に動かす × 4 + 動くコマの終端の行]. 動かせなければ -1
+    std::vector<std::array<int32_t, 8>> next_indices;
+    std::unordered_map<uint64_t, int32_t> indices;
 };
 
-// h コストが 0 なら終端
-inline bool FifteenPuzzleState::is_done() const {
-    return h_cost == 0;
+// 初めて呼ばれたときに表を作る
+const WalkingDistanceTable& walking_distance_table();
+
+// 行について表の添字を求めた後, 盤面を転置して列についても求める
+template <class Geometry>
+int WalkingDistance<Geometry>::initialize(Data& data, const PackedBoard numbers, const PackedBoard) {
+    const auto& table = walking_distance_table();
+    int32_t indices[2];
+    for (int is_column = 0; is_column < 2; ++is_column) {
+        uint64_t key = 0;
+        for (int line = 0; line < 4; ++line) {
+            int counts[4] = {};
+            for (int i = 0; i < 4; ++i) {
+                const int cell = is_column ? (i << 2) + line : (line << 2) + i;
+                const int number = get_nibble(numbers, cell);
+                if (number == 0) {
+                    key |= uint64_t(line) << 48;
+                } else {
+                    const auto [terminal_h, terminal_w] = get_coordinate(terminal_positions[number]);
+                    ++counts[is_column ? terminal_w : terminal_h];
+                }
+            }
+            for (int terminal_line = 0; terminal_line < 4; ++terminal_line) {
+                key |= uint64_t(counts[terminal_line]) << (3 * (15 - (line * 4 + terminal_line)));
+            }
+        }
+        indices[is_column] = table.indices.at(key);
+    }
+    data.row_index = indices[0];
+    data.column_index = indices[1];
+    return table.distances[data.row_index] + table.distances[data.column_index];
 }
 
-inline int FifteenPuzzleState::get_f_cost() const {
-    return g_cost + h_cost;
+template <class Geometry>
+inline int WalkingDistance<Geometry>::update(Data& data, const PackedBoard, const PackedBoard, const int number, const int from, const int to) {
+    const auto& table = walking_distance_table();
+    const auto [terminal_h, terminal_w] = get_coordinate(terminal_positions[number]);
+    const int h_cost = table.distances[data.row_index] + table.distances[data.column_index];
+    // コマが下 (右) に動けば空白は上 (左) に動く
+    if ((from >> 2) != (to >> 2)) {
+        data.row_index = table.next_indices[data.row_index][(from > to ? 4 : 0) + terminal_h];
+    } else {
+        data.column_index = table.next_indices[data.column_index][(from > to ? 4 : 0) + terminal_w];
+    }
+    return table.distances[data.row_index] + table.distances[data.column_index] - h_cost;
 }
 
-// f コストの比較
-// 12.ida_star では自動でメモリを解放するように std::shared_ptr を使用する
-static inline auto compare_f_cost = [](const std::shared_ptr<FifteenPuzzleState> state1, const std::shared_ptr<FifteenPuzzleState> state2) -> bool {
-    return state1->get_f_cost() > state2->get_f_cost();
-};
+} // namespace heuristic
+
+// 状態は sliding_puzzle の 4x4 の状態そのもので, h コストの方針だけを選ぶ
+template <template <class> class Heuristic = heuristic::Manhattan>
+using BasicFifteenPuzzleState = sliding_puzzle::BasicSlidingPuzzleState<4, 4, Heuristic>;
 
+using FifteenPuzzleState = BasicFifteenPuzzleState<>;
 using State = FifteenPuzzleState;
-using StatePtr = std::shared_ptr<FifteenPuzzleState>;
 using Action = int;
 
 Action random_action(const State& state);
 
-} // namespace fifteen_puzzle
\ No newline at end of file
+// 終端状態から 100 回程度ランダムにスライドさせた, 解くことのできる盤面
+std::array<int, 16> random_walk_board();
+
+// 終端状態ではなく, 任意の盤面 target までのマンハッタン距離 (双方向探索の後ろ向きの h コストに使う)
+// 状態の差分更新には乗らないので, 呼ぶたびに盤面全体から計算する
+class TargetManhattanHeuristic {
+public:
+    // target[セル番号] = コマ番号
+    explicit TargetManhattanHeuristic(const std::array<int, 16>& target) {
+        for (int cell = 0; cell < 16; ++cell) {
+            const auto [target_h, target_w] = get_coordinate(cell);
+            for (int from = 0; from < 16; ++from) {
+                const auto [h, w] = get_coordinate(from);
+                distances_[target[cell]][from] = target[cell] == 0 ? 0 : std::abs(h - target_h) + std::abs(w - target_w);
+            }
+        }
+    }
+
+    template <template <class> class H>
+    int operator()(const BasicFifteenPuzzleState<H>& state) const {
+        const PackedBoard positions = state.packed_positions();
+        int h_cost = 0;
+        for (int number = 1; number < 16; ++number) {
+            h_cost += distances_[number][get_nibble(positions, number)];
+        }
+        return h_cost;
+    }
+
+private:
+    // distances_[コマ番号][セル番号]
+    std::array<std::array<uint8_t, 16>, 16> distances_{};
+};
+
+// numbers[セル番号] = コマ番号 の盤面を終端状態まで動かせるか
+// 終端状態からの置換 (空白を含む) の偶奇が, 空白の終端位置までのマンハッタン距離の偶奇と一致すれば解ける
+bool is_solvable(const std::array<int, 16>& numbers);
+
+// 解ける盤面の中から一様に 1 つ選ぶ
+// コマを一様に並べ替え, 解けなければ空白以外の 2 枚を入れ替える (解けない盤面と解ける盤面が 1 対 1 に対応する)
+std::array<int, 16> random_board(std::mt19937_64& engine);
+
+// 問題集を読み込む. 1 行に 1 問, セル番号順に 16 個のコマ番号を並べる (Korf の 100 問の形式)
+// この形式の終端状態は "0 1 2 ... 15" (空白が左上) なので, 盤面を 180 度回転してコマ番号 n を 16 - n に付け替える
+// 行頭に問題番号があれば (17 個の数なら) 読み飛ばす. 空行と # で始まる行は無視する
+// 読めない行があれば false
+bool load_boards(const std::string& path, std::vector<std::array<int, 16>>& boards);
+
+template <template <class> class Heuristic>
+bool load_instances(const std::string& path, std::vector<BasicFifteenPuzzleState<Heuristic>>& instances) {
+    std::vector<std::array<int, 16>> boards;
+    if (!load_boards(path, boards)) {
+        return false;
+    }
+    for (const auto& numbers : boards) {
+        instances.emplace_back(numbers);
+    }
+    return true;
+}
+
+} // namespace fifteen_puzzle
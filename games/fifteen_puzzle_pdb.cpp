@@ -0,0 +1,64 @@
+#include "fifteen_puzzle_pdb.hpp"
+
+#include <cstring>
+#include <fstream>
+
+namespace fifteen_puzzle {
+
+static constexpr char MAGIC[4] = {'F', 'P', 'D', 'B'};
+
+bool PatternDatabase::load(const std::string& path) {
+    entries_ = nullptr;
+    pattern_.clear();
+    if (!file_.open(path) || file_.size() < sizeof(FileHeader)) {
+        return false;
+    }
+    FileHeader header;
+    std::memcpy(&header, file_.data(), sizeof(FileHeader));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.tile_count == 0 || header.tile_count > 15
+        || header.entry_count != placement_count(header.tile_count) || file_.size() != sizeof(FileHeader) + header.entry_count) {
+        file_.close();
+        return false;
+    }
+    pattern_.assign(header.tiles, header.tiles + header.tile_count);
+    entries_ = file_.data() + sizeof(FileHeader);
+    return true;
+}
+
+bool PatternDatabase::save(const std::string& path, const Pattern& pattern, const std::vector<uint8_t>& entries) {
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.tile_count = pattern.size();
+    for (std::size_t i = 0; i < pattern.size(); ++i) {
+        header.tiles[i] = pattern[i];
+    }
+    header.entry_count = entries.size();
+    std::ofstream ofs(path, std::ios::binary);
+    ofs.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+    ofs.write(reinterpret_cast<const char*>(entries.data()), entries.size());
+    return static_cast<bool>(ofs);
+}
+
+bool AdditivePatternDatabase::load(const std::string& directory, const std::vector<Pattern>& partition) {
+    databases_.clear();
+    for (const auto& pattern : partition) {
+        auto database = std::make_unique<PatternDatabase>();
+        if (!database->load(directory + "/" + file_name(pattern)) || database->pattern() != pattern) {
+            databases_.clear();
+            return false;
+        }
+        databases_.emplace_back(std::move(database));
+    }
+    return true;
+}
+
+std::string AdditivePatternDatabase::file_name(const Pattern& pattern) {
+    std::string name = "fifteen_pdb";
+    for (std::size_t i = 0; i < pattern.size(); ++i) {
+        name += i ? '-' : '_';
+        name += std::to_string(pattern[i]);
+    }
+    return name + ".bin";
+}
+
+} // namespace fifteen_puzzle
@@ -0,0 +1,130 @@
+/*
+15 パズルの加算的な互いに素なパターンデータベース (additive disjoint pattern database)
+コマを互いに素なパターンに分け, パターンごとに「そのパターンのコマだけを動かす手数」の最小値を
+パターンのコマの配置ごとに 1 バイトで記録しておく
+パターン外のコマは区別せず, 空白が動く手はパターンのコマを動かしたときだけ数えるので, 各パターンの値を足しても許容的である
+
+ファイルは FileHeader に続けて, 配置の番号 (rank_placement) の順に 1 バイトずつ値を並べたもの
+読み込みは mmap で行う. 21.pattern_database で生成する
+*/
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "fifteen_puzzle.hpp"
+#include "../utils/mapped_file.hpp"
+
+namespace fifteen_puzzle {
+
+// パターンに含めるコマ番号の並び
+using Pattern = std::vector<int>;
+
+// 6-6-3 分割
+//  1 |  3 |  3 |  3     ( 3 の 3 枚は 1 行目の 2, 3, 4 番)
+//  1 |  1 |  2 |  2
+//  1 |  1 |  2 |  2
+//  1 |  2 |  2 |  0
+inline const std::vector<Pattern> PARTITION_663 = {{1, 5, 6, 9, 10, 13}, {7, 8, 11, 12, 14, 15}, {2, 3, 4}};
+
+// k 枚のコマを 16 セルに置く方法の数 16! / (16 - k)!
+constexpr uint32_t placement_count(const int k) {
+    uint32_t count = 1;
+    for (int i = 0; i < k; ++i) {
+        count *= 16 - i;
+    }
+    return count;
+}
+
+// 互いに異なる k 個のセル cells[0 ~ k - 1] を, 0 ~ placement_count(k) - 1 の整数に 1 対 1 に写す
+// i 番目のセルを, それより前に使われていないセルの中で何番目かに置き換えた混合基数の数
+inline uint32_t rank_placement(const int* cells, const int k) {
+    uint32_t used = 0;
+    uint32_t rank = 0;
+    for (int i = 0; i < k; ++i) {
+        const int cell = cells[i];
+        rank = rank * (16 - i) + (cell - std::popcount(used & ((1u << cell) - 1)));
+        used |= 1u << cell;
+    }
+    return rank;
+}
+
+// ファイルの先頭に置く情報
+struct FileHeader {
+    char magic[4];
+    uint32_t tile_count;
+    uint8_t tiles[16];
+    uint64_t entry_count;
+};
+
+class PatternDatabase {
+public:
+    // path のファイルをマップする. 形式が正しくなければ false
+    bool load(const std::string& path);
+
+    // entries[rank_placement(パターンのコマのセル)] を path に書き出す
+    static bool save(const std::string& path, const Pattern& pattern, const std::vector<uint8_t>& entries);
+
+    const Pattern& pattern() const;
+
+    // positions: インデックスがコマ番号, 値がセル番号の盤面
+    int lookup(const PackedBoard positions) const;
+
+private:
+    MappedFile file_;
+    const uint8_t* entries_ = nullptr;
+    Pattern pattern_;
+};
+
+// 分割したパターンごとの値の和を h コストとする
+class AdditivePatternDatabase {
+public:
+    // directory にある file_name(pattern) をすべて読み込む. どれか 1 つでも読めなければ false
+    bool load(const std::string& directory, const std::vector<Pattern>& partition = PARTITION_663);
+
+    int operator()(const State& state) const;
+
+    // パターンのファイル名 (例: fifteen_pdb_2-3-4.bin)
+    static std::string file_name(const Pattern& pattern);
+
+private:
+    // MappedFile はコピーできないので, ポインタで持つ
+    std::vector<std::unique_ptr<PatternDatabase>> databases_;
+};
+
+// 探索の Heuristic として渡す. 参照先の AdditivePatternDatabase は探索中に解放しないこと
+struct PatternDatabaseHeuristic {
+    const AdditivePatternDatabase* database;
+
+    int operator()(const State& state) const {
+        return (*database)(state);
+    }
+};
+
+inline const Pattern& PatternDatabase::pattern() const {
+    return pattern_;
+}
+
+inline int PatternDatabase::lookup(const PackedBoard positions) const {
+    int cells[16];
+    const int k = pattern_.size();
+    for (int i = 0; i < k; ++i) {
+        cells[i] = get_nibble(positions, pattern_[i]);
+    }
+    return entries_[rank_placement(cells, k)];
+}
+
+inline int AdditivePatternDatabase::operator()(const State& state) const {
+    const PackedBoard positions = state.packed_positions();
+    int h_cost = 0;
+    for (const auto& database : databases_) {
+        h_cost += database->lookup(positions);
+    }
+    return h_cost;
+}
+
+} // namespace fifteen_puzzle
@@ -0,0 +1,233 @@
+/*
+並列の対戦
+ゲームをスレッドプールに分配し, ゲームごとの勝敗を atomic な配列に書き込んで, ロックを取らずに集計する
+プレイヤーはゲームごとに生成関数 make_player(seed) で作る. seed は (全体の種, ゲーム番号, プレイヤー番号) から決まるので,
+プレイヤーの乱数をすべて seed から作れば, スレッド数や実行順によらず同じ対局になる
+SPRT (逐次確率比検定) を指定すると, 強さの差が統計的に決まった時点で残りのゲームを打ち切る
+打ち切りの判定はゲーム番号順に並べた結果の先頭部分だけで行うので, 打ち切る位置と集計結果もスレッド数によらない
+テンプレートを使用するためにヘッダに実装を書いている
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "play.hpp"
+#include "../utils/thread_pool.hpp"
+
+namespace play {
+
+// H0: players[0] の players[1] に対する Elo レーティング差が elo0, H1: elo1
+// alpha: H0 が正しいときに H1 を採択する確率, beta: H1 が正しいときに H0 を採択する確率
+struct SprtParameters {
+    double elo0 = 0.;
+    double elo1 = 50.;
+    double alpha = 0.05;
+    double beta = 0.05;
+};
+
+enum class SprtStatus {
+    CONTINUE, ACCEPT_H0, ACCEPT_H1
+};
+
+struct MatchOptions {
+    // 打ち切らなかったときのゲーム数
+    int game_number = 100;
+    int thread_count = std::thread::hardware_concurrency();
+    uint64_t seed = 0;
+    // 指定すれば SPRT で打ち切る
+    std::optional<SprtParameters> sprt;
+};
+
+// players[0] から見た集計結果
+struct MatchResult {
+    int win = 0;
+    int lose = 0;
+    int draw = 0;
+    // SPRT の対数尤度比と判定
+    double llr = 0.;
+    SprtStatus sprt_status = SprtStatus::CONTINUE;
+
+    int game_count() const;
+
+    // 勝ちを 1, 引き分けを 0.5 とした平均得点
+    double score() const;
+
+    // 平均得点から求めた Elo レーティング差と, その 95% 信頼区間 [elo_lower, elo_upper]
+    double elo() const;
+    double elo_lower() const;
+    double elo_upper() const;
+
+private:
+    double score_error() const;
+};
+
+// 平均得点 score に対応する Elo レーティング差
+inline double score_to_elo(const double score) {
+    return -400. * std::log10(1. / score - 1.);
+}
+
+inline double elo_to_score(const double elo) {
+    return 1. / (1. + std::pow(10., -elo / 400.));
+}
+
+inline int MatchResult::game_count() const {
+    return win + lose + draw;
+}
+
+inline double MatchResult::score() const {
+    return (win + 0.5 * draw) / game_count();
+}
+
+// 1 ゲームの得点の標準偏差から求めた, 平均得点の 95% 信頼区間の幅の半分
+inline double MatchResult::score_error() const {
+    const double s = score();
+    const double variance = (win * (1. - s) * (1. - s) + lose * s * s + draw * (0.5 - s) * (0.5 - s)) / game_count();
+    return 1.96 * std::sqrt(variance / game_count());
+}
+
+inline double MatchResult::elo() const {
+    return score_to_elo(score());
+}
+
+inline double MatchResult::elo_lower() const {
+    return score_to_elo(std::max(0., score() - score_error()));
+}
+
+inline double MatchResult::elo_upper() const {
+    return score_to_elo(std::min(1., score() + score_error()));
+}
+
+// 得点を正規分布で近似した SPRT (GSPRT) の対数尤度比
+inline double sprt_llr(const int win, const int lose, const int draw, const SprtParameters& parameters) {
+    const int n = win + lose + draw;
+    if (n == 0) {
+        return 0.;
+    }
+    const double s = (win + 0.5 * draw) / n;
+    // 全勝などで分散が 0 になると判定できないので, 勝ちと負けを 1 回ずつ加えたときの分散を下限にする
+    const double s_prior = (win + 1 + 0.5 * draw) / (n + 2);
+    const double variance = std::max((win * (1. - s) * (1. - s) + lose * s * s + draw * (0.5 - s) * (0.5 - s)) / n,
+                                     ((win + 1) * (1. - s_prior) * (1. - s_prior) + (lose + 1) * s_prior * s_prior + draw * (0.5 - s_prior) * (0.5 - s_prior)) / (n + 2));
+    const double s0 = elo_to_score(parameters.elo0);
+    const double s1 = elo_to_score(parameters.elo1);
+    return n * (s1 - s0) * (2. * s - s0 - s1) / (2. * variance);
+}
+
+inline SprtStatus sprt_status(const double llr, const SprtParameters& parameters) {
+    if (llr <= std::log(parameters.beta / (1. - parameters.alpha))) {
+        return SprtStatus::ACCEPT_H0;
+    }
+    if (llr >= std::log((1. - parameters.beta) / parameters.alpha)) {
+        return SprtStatus::ACCEPT_H1;
+    }
+    return SprtStatus::CONTINUE;
+}
+
+// (全体の種, ゲーム番号, プレイヤー番号) から決まるプレイヤーの乱数の種 (splitmix64)
+inline uint64_t player_seed(const uint64_t seed, const int game_index, const int player_index) {
+    uint64_t x = seed + 0x9E3779B97F4A7C15 * (2 * static_cast<uint64_t>(game_index) + player_index + 1);
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EB;
+    return x ^ (x >> 31);
+}
+
+// options.game_number 回まで players[0] と players[1] を並列に対戦させ, players[0] から見た結果を返す
+// make_player0(seed), make_player1(seed) はそのゲームで使うプレイヤー (State を受け取って Action を返す関数オブジェクト) を返す
+// 先手はゲーム番号の偶奇で入れ替える (test_ai と同じ)
+template <class State, class MakePlayer0, class MakePlayer1>
+MatchResult run_match(const MakePlayer0& make_player0, const MakePlayer1& make_player1, const MatchOptions& options) {
+    const int game_number = options.game_number;
+    // ゲームごとの players[0] から見た勝敗. 終わっていなければ NONE
+    std::vector<std::atomic<WinningStatus>> results(game_number);
+    for (auto& result : results) {
+        result.store(WinningStatus::NONE, std::memory_order_relaxed);
+    }
+    std::atomic<bool> is_stopped = false;
+
+    // 以下は is_scanning を取ったスレッドだけが触る
+    std::atomic_flag is_scanning;
+    int scanned_count = 0;
+    MatchResult match_result;
+
+    // ゲーム番号順に, 終わったゲームの結果を集計に加える
+    // 他のスレッドが走査中なら任せる. 走査を終えた後に次のゲームが終わっていれば, 書いたスレッドが走査を取れなかった可能性があるので続ける
+    const auto scan = [&] {
+        while (!is_scanning.test_and_set()) {
+            for (; scanned_count < game_number && !is_stopped.load(); ++scanned_count) {
+                const WinningStatus result = results[scanned_count].load();
+                if (result == WinningStatus::NONE) {
+                    break;
+                }
+                match_result.win += result == WinningStatus::WIN;
+                match_result.lose += result == WinningStatus::LOSE;
+                match_result.draw += result == WinningStatus::DRAW;
+                if (options.sprt) {
+                    match_result.llr = sprt_llr(match_result.win, match_result.lose, match_result.draw, *options.sprt);
+                    match_result.sprt_status = sprt_status(match_result.llr, *options.sprt);
+                    if (match_result.sprt_status != SprtStatus::CONTINUE) {
+                        is_stopped.store(true);
+                    }
+                }
+            }
+            const int next_index = scanned_count;
+            is_scanning.clear();
+            if (next_index >= game_number || is_stopped.load() || results[next_index].load() == WinningStatus::NONE) {
+                break;
+            }
+        }
+    };
+
+    // スレッドプールのタスクは後に積んだものから実行されるので, ゲームごとのタスクにするとゲーム番号の大きい方から進み, 打ち切りが遅れる
+    // そこでスレッドごとに 1 つのタスクを積み, 各タスクがゲーム番号の小さい順に次のゲームを取る
+    std::atomic<int> next_game_index = 0;
+    {
+        WorkStealingPool pool(options.thread_count);
+        for (int t = 0; t < pool.thread_count(); ++t) {
+            pool.submit([&] {
+                for (int game_index = next_game_index++; game_index < game_number && !is_stopped.load(); game_index = next_game_index++) {
+                    auto player0 = make_player0(player_seed(options.seed, game_index, 0));
+                    auto player1 = make_player1(player_seed(options.seed, game_index, 1));
+                    results[game_index].store(play_game<State>(player0, player1, game_index & 1, false).first);
+                    scan();
+                }
+            });
+        }
+        pool.wait_idle();
+    }
+    scan();
+    return match_result;
+}
+
+// run_match の結果を test_ai と同じ形式で出力し, Elo レーティング差と SPRT の判定を加える
+inline void print_match_result(const MatchResult& result, const MatchOptions& options) {
+    std::cout << "Win\t" << result.win << std::endl;
+    std::cout << "Lose\t" << result.lose << std::endl;
+    std::cout << "Draw\t" << result.draw << std::endl;
+    std::cout << "Win rate\t" << static_cast<double>(result.win) / result.game_count() << std::endl;
+    std::cout << "Games\t" << result.game_count() << " / " << options.game_number << std::endl;
+    std::cout << "Elo\t" << result.elo() << " [" << result.elo_lower() << ", " << result.elo_upper() << "]" << std::endl;
+    if (options.sprt) {
+        std::cout << "SPRT (" << options.sprt->elo0 << ", " << options.sprt->elo1 << ")\tLLR " << result.llr << '\t';
+        switch (result.sprt_status) {
+        case SprtStatus::ACCEPT_H0:
+            std::cout << "H0 accepted" << std::endl;
+            break;
+        case SprtStatus::ACCEPT_H1:
+            std::cout << "H1 accepted" << std::endl;
+            break;
+        default:
+            std::cout << "undecided" << std::endl;
+            break;
+        }
+    }
+}
+
+} // namespace play
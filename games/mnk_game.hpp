@@ -0,0 +1,190 @@
+/*
+m,n,k ゲームの実装
+Height 行 Width 列の盤面に交互にコマを置き, 縦・横・斜めに K 個並べたら勝ち
+三目並べ (3,3,3) を一般化したもので, 4x4x4, 5x5x4, 7x7x5 (五目並べの縮小版) などで探索の性能を測るために使う
+ビットボードは 1 行を Width + 1 ビットとし, 各行の右端に常に 0 のビットを置いて横・斜めのシフトが隣の行に回り込まないようにする
+盤面が 64 ビットに収まらなければ 128 ビットの整数を使う
+zobrist hashing 付き
+テンプレートを使用するためにヘッダに実装を書いている
+*/
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <ostream>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "play.hpp"
+#include "../utils/zobrist_hashing.hpp"
+
+namespace mnk_game {
+
+template <int Height, int Width, int K>
+class MNKState {
+public:
+    static_assert(K >= 2 && (K <= Height || K <= Width), "K must fit on the board");
+
+    static constexpr int STRIDE = Width + 1;
+    static constexpr int BIT_COUNT = Height * STRIDE;
+    static_assert(BIT_COUNT <= 128, "board must fit in 128 bits");
+
+    using BitBoard = std::conditional_t<(BIT_COUNT <= 64), uint64_t, unsigned __int128>;
+    using HashValue = zobrist_hashing::HashValue;
+
+    unsigned int turn = 0;
+    bool is_black_turn = 1;
+
+    HashValue hash_value = 0;
+
+    void step(const BitBoard action);
+
+    bool is_done() const;
+
+    std::vector<BitBoard> legal_actions() const;
+
+    int count_legal_actions() const;
+
+    WinningStatus get_winning_status() const;
+
+    template <int H, int W, int L>
+    friend std::ostream& operator<<(std::ostream& os, const MNKState<H, W, L>& state);
+
+    // 各行の盤面内のマスのビットを立てたマスク
+    static constexpr BitBoard FULL_POS = [] {
+        BitBoard position = 0;
+        for (int h = 0; h < Height; ++h) {
+            for (int w = 0; w < Width; ++w) {
+                position |= BitBoard(1) << (h * STRIDE + w);
+            }
+        }
+        return position;
+    }();
+
+    // keys[後手なら 1][ビットの位置]
+    static constexpr auto keys = zobrist_hashing::make_key_table<2, BIT_COUNT>(0x6D6E6B5F67616D65 ^ (Height << 16 | Width << 8 | K));
+
+    static int bit_index(const BitBoard piece);
+
+    static bool has_k_sequences(const BitBoard position);
+
+private:
+    BitBoard player_position_ = 0;
+    BitBoard opponent_position_ = 0;
+    // 直前の手で K 個並んだか. 並べたのは相手側 (opponent_position_) になる
+    bool is_last_action_winning_ = false;
+};
+
+template <int Height, int Width, int K>
+inline int MNKState<Height, Width, K>::bit_index(const BitBoard piece) {
+    if constexpr (BIT_COUNT <= 64) {
+        return std::countr_zero(piece);
+    } else {
+        const auto low = static_cast<uint64_t>(piece);
+        return low ? std::countr_zero(low) : 64 + std::countr_zero(static_cast<uint64_t>(piece >> 64));
+    }
+}
+
+// 縦・横・斜めの 4 方向それぞれで, K - 1 回のシフトと AND で K 個の連続を検出する
+// シフト量と回数はコンパイル時に決まるので, ループは展開される
+template <int Height, int Width, int K>
+inline bool MNKState<Height, Width, K>::has_k_sequences(const BitBoard position) {
+    const auto sequences = [position]<int Shift>() {
+        return [position]<std::size_t... I>(std::index_sequence<I...>) {
+            BitBoard x = position;
+            ((x &= x >> Shift, static_cast<void>(I)), ...);
+            return x;
+        }(std::make_index_sequence<K - 1>());
+    };
+    return (sequences.template operator()<1>() | sequences.template operator()<STRIDE>()
+          | sequences.template operator()<STRIDE + 1>() | sequences.template operator()<STRIDE - 1>()) != 0;
+}
+
+template <int Height, int Width, int K>
+inline void MNKState<Height, Width, K>::step(const BitBoard action) {
+    player_position_ |= action;
+    hash_value ^= keys[!is_black_turn][bit_index(action)];
+    is_last_action_winning_ = has_k_sequences(player_position_);
+    std::swap(player_position_, opponent_position_);
+    ++turn;
+    is_black_turn = !is_black_turn;
+}
+
+// K 個並んだか, すべてのマスにコマが置かれていれば終端
+template <int Height, int Width, int K>
+inline bool MNKState<Height, Width, K>::is_done() const {
+    return is_last_action_winning_ || (player_position_ | opponent_position_) == FULL_POS;
+}
+
+template <int Height, int Width, int K>
+inline std::vector<typename MNKState<Height, Width, K>::BitBoard> MNKState<Height, Width, K>::legal_actions() const {
+    std::vector<BitBoard> actions;
+    BitBoard pieces = ~(player_position_ | opponent_position_) & FULL_POS;
+    while (pieces) {
+        // x & -x で x の最も下位にある 1 ビットを取得できる
+        BitBoard action = pieces & -pieces;
+        actions.emplace_back(action);
+        pieces ^= action;
+    }
+    return actions;
+}
+
+template <int Height, int Width, int K>
+inline int MNKState<Height, Width, K>::count_legal_actions() const {
+    return is_done() ? 0 : Height * Width - static_cast<int>(turn);
+}
+
+template <int Height, int Width, int K>
+inline WinningStatus MNKState<Height, Width, K>::get_winning_status() const {
+    if (is_last_action_winning_) {
+        return WinningStatus::LOSE;
+    } else if ((player_position_ | opponent_position_) == FULL_POS) {
+        return WinningStatus::DRAW;
+    } else {
+        return WinningStatus::NONE;
+    }
+}
+
+// ゲーム状況の出力
+template <int Height, int Width, int K>
+std::ostream& operator<<(std::ostream& os, const MNKState<Height, Width, K>& state) {
+    using BitBoard = typename MNKState<Height, Width, K>::BitBoard;
+    const BitBoard black_position = state.is_black_turn ? state.player_position_ : state.opponent_position_;
+    const BitBoard white_position = state.is_black_turn ? state.opponent_position_ : state.player_position_;
+
+    os << "Turn\t" << state.turn << '\n';
+    for (int h = 0; h < Height; ++h) {
+        for (int w = 0; w < Width; ++w) {
+            const BitBoard piece = BitBoard(1) << (h * MNKState<Height, Width, K>::STRIDE + w);
+            if (w) os << ' ';
+            if (black_position & piece) {
+                os << 'x';
+            } else if (white_position & piece) {
+                os << 'o';
+            } else {
+                os << '.';
+            }
+        }
+        os << '\n';
+    }
+    return os;
+}
+
+template <class State>
+auto random_action(const State& state) {
+    static std::mt19937 engine{std::random_device()()};
+    const auto legal_actions = state.legal_actions();
+    return legal_actions[engine() % legal_actions.size()];
+}
+
+// よく使う盤面
+using TicTacToeState = MNKState<3, 3, 3>;
+using State444 = MNKState<4, 4, 4>;
+using State543 = MNKState<5, 4, 3>;
+using State554 = MNKState<5, 5, 4>;
+using State775 = MNKState<7, 7, 5>;
+
+} // namespace mnk_game
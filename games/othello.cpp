@@ -15,14 +15,26 @@ score::ScoreType score::compute_score(const BitBoard position) {
 }
 
 void OthelloState::step(const BitBoard action) {
-    if (action) {
-        put_piece(action);
-    }
+    UndoInfo undo_info;
+    step(action, undo_info);
+}
+
+void OthelloState::step(const BitBoard action, UndoInfo& undo_info) {
+    undo_info = action ? put_piece(action) : 0;
     std::swap(player_position_, opponent_position_);
     ++turn;
     is_black_turn = !is_black_turn;
 }
 
+// 置いたコマを取り除き, 返したコマを相手側に戻す
+void OthelloState::undo(const BitBoard action, const UndoInfo undo_info) {
+    is_black_turn = !is_black_turn;
+    --turn;
+    std::swap(player_position_, opponent_position_);
+    player_position_ ^= action | undo_info;
+    opponent_position_ ^= undo_info;
+}
+
 std::vector<BitBoard> OthelloState::legal_actions() const {
     std::vector<BitBoard> actions;
     BitBoard pieces = cells_can_put(player_position_, opponent_position_);
@@ -84,7 +96,7 @@ std::ostream& operator<<(std::ostream& os, const OthelloState& state) {
     return os;
 }
 
-void OthelloState::put_piece(const BitBoard piece) {
+BitBoard OthelloState::put_piece(const BitBoard piece) {
     BitBoard flip_pieces = 0;
     if (auto piece_sequence = opponent_pieces_adjacent_left(piece, opponent_position_); (piece_sequence >> 1) & player_position_) {
         flip_pieces |= piece_sequence;
@@ -112,6 +124,7 @@ void OthelloState::put_piece(const BitBoard piece) {
     }
     player_position_ ^= piece | flip_pieces;
     opponent_position_ ^= flip_pieces;
+    return flip_pieces;
 }
 
 // position のコマの左に連続する相手コマを列挙
@@ -219,6 +232,10 @@ BitBoard OthelloState::cells_can_put(const BitBoard position, const BitBoard opp
 
 Action random_action(const State& state) {
     static std::mt19937 engine{std::random_device()()};
+    return random_action(state, engine);
+}
+
+Action random_action(const State& state, std::mt19937& engine) {
     const auto legal_actions = state.legal_actions();
     if (legal_actions.empty()) {
         return NO_POS;
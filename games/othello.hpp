@@ -8,9 +8,11 @@
 #include <bit>
 #include <vector>
 #include <ostream>
+#include <random>
 #include <unordered_map>
 
 #include "play.hpp"
+#include "../utils/zobrist_hashing.hpp"
 
 namespace othello {
 
@@ -22,6 +24,16 @@ static int count_pieces(const BitBoard position) {
     return std::popcount(position);
 }
 
+namespace zobrist_hashing {
+
+using HashValue = ::zobrist_hashing::HashValue;
+
+// keys[バイト位置 (手番側は 0 ~ 7, 相手側は 8 ~ 15)][そのバイトの値]
+// コマを返すと多くのマスが変わるので, 差分更新せずに 8 バイトずつ表を引いて計算する
+inline constexpr auto keys = ::zobrist_hashing::make_key_table<16, 256>(0x6F7468656C6C6F5F);
+
+} // namespace zobrist_hashing
+
 namespace score {
 
 using ScoreType = int;
@@ -47,21 +59,36 @@ ScoreType compute_score(const BitBoard position);
 
 class OthelloState {
 public:
+    // step で返したコマの位置. undo で元に戻すのに使う
+    using UndoInfo = BitBoard;
+
     unsigned int turn = 0;
     bool is_black_turn = 1;
 
     void step(const BitBoard action);
 
+    // 返したコマの位置を undo_info に書き込む
+    void step(const BitBoard action, UndoInfo& undo_info);
+
+    // step(action, undo_info) の直後に呼ぶと, その手を取り消す
+    void undo(const BitBoard action, const UndoInfo undo_info);
+
     bool is_done() const;
 
     std::vector<BitBoard> legal_actions() const;
 
+    int count_legal_actions() const;
+
     score::ScoreType get_score() const;
 
     score::ScoreType get_score2() const;
 
+    int count_empties() const;
+
     WinningStatus get_winning_status() const;
 
+    zobrist_hashing::HashValue hash_value() const;
+
     friend std::ostream& operator<<(std::ostream& os, const OthelloState& state);
 
 private:
@@ -69,7 +96,8 @@ private:
     BitBoard player_position_ = 0x0000000810000000;
     BitBoard opponent_position_ = 0x0000001008000000;
 
-    void put_piece(const BitBoard piece);
+    // コマを置いて挟んだコマを返し, 返したコマの位置を返す
+    BitBoard put_piece(const BitBoard piece);
 
     BitBoard opponent_pieces_adjacent_left(BitBoard position, const BitBoard opponent_position) const;
     BitBoard opponent_pieces_adjacent_right(BitBoard position, const BitBoard opponent_position) const;
@@ -100,9 +128,32 @@ inline score::ScoreType OthelloState::get_score2() const {
     return score::compute_score(player_position_) - score::compute_score(opponent_position_);
 }
 
+// 合法手を列挙せずに数える
+inline int OthelloState::count_legal_actions() const {
+    return count_pieces(cells_can_put(player_position_, opponent_position_));
+}
+
+// 空きマスの数
+inline int OthelloState::count_empties() const {
+    return 64 - count_pieces(player_position_ | opponent_position_);
+}
+
+// 手番側と相手側のコマ配置から計算するので, 色が入れ替わっただけの局面は同じハッシュ値になる
+inline zobrist_hashing::HashValue OthelloState::hash_value() const {
+    zobrist_hashing::HashValue hash_value = 0;
+    for (int byte = 0; byte < 8; ++byte) {
+        hash_value ^= zobrist_hashing::keys[byte][(player_position_ >> (byte * 8)) & 0xFF];
+        hash_value ^= zobrist_hashing::keys[byte + 8][(opponent_position_ >> (byte * 8)) & 0xFF];
+    }
+    return hash_value;
+}
+
 using State = othello::OthelloState;
 using Action = othello::BitBoard;
 
 Action random_action(const State& state);
 
+// engine で手を選ぶ. 対局ごとに種を決めた engine を渡せば, 同じ対局を再現できる
+Action random_action(const State& state, std::mt19937& engine);
+
 } // namespace othello
\ No newline at end of file
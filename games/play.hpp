@@ -21,17 +21,22 @@ template <class State, class Action>
 using Player = std::function<Action(const State&)>;
 
 // 終端までゲームをプレイして, 両プレイヤーの勝敗を返す.
+// player0, player1 は State を受け取って Action を返す関数オブジェクトで, 型消去せずに呼び出す
 // black_side: 先手側. 公平性確保のため, プレイごとに入れ替える
 // is_print: ゲーム状況出力フラグ
-template<class State, class Action>
-std::pair<WinningStatus, WinningStatus> play_game(const std::array<Player<State, Action>, 2>& players, const int black_side, const bool is_print) {
+template <class State, class Player0, class Player1>
+std::pair<WinningStatus, WinningStatus> play_game(Player0&& player0, Player1&& player1, const int black_side, const bool is_print) {
     auto state = State();
     int player = black_side;
     while (!state.is_done()) {
         if (is_print) {
             std::cout << state << std::endl;
         }
-        state.step(players[player](state));
+        if (player == 0) {
+            state.step(player0(state));
+        } else {
+            state.step(player1(state));
+        }
         player = 1 - player;
     }
     if (is_print) {
@@ -55,13 +60,18 @@ std::pair<WinningStatus, WinningStatus> play_game(const std::array<Player<State,
     }
 }
 
-// game_number 回ゲームをプレイして, players[0] の players[1] に対する勝率などを出力する.
-template <class State, class Action>
-void test_ai(const std::array<Player<State, Action>, 2>& players, const int game_number) {
+template<class State, class Action>
+std::pair<WinningStatus, WinningStatus> play_game(const std::array<Player<State, Action>, 2>& players, const int black_side, const bool is_print) {
+    return play_game<State>(players[0], players[1], black_side, is_print);
+}
+
+// game_number 回ゲームをプレイして, player0 の player1 に対する勝率などを出力する.
+template <class State, class Player0, class Player1>
+void test_ai(Player0&& player0, Player1&& player1, const int game_number) {
     // [0]: 勝利回数, [1]: 敗北回数, [2]: 引き分け回数
     int results[3] = {};
     for (int t = 0; t < game_number; ++t) {
-        const auto [p1_result, p2_result] = play_game(players, t & 1, false);
+        const auto [p1_result, p2_result] = play_game<State>(player0, player1, t & 1, false);
         switch (p1_result) {
         case WinningStatus::WIN:
             ++results[0];
@@ -80,4 +90,10 @@ void test_ai(const std::array<Player<State, Action>, 2>& players, const int game
     std::cout << "Win rate\t" << static_cast<double>(results[0]) / game_number << std::endl;
 }
 
+// game_number 回ゲームをプレイして, players[0] の players[1] に対する勝率などを出力する.
+template <class State, class Action>
+void test_ai(const std::array<Player<State, Action>, 2>& players, const int game_number) {
+    test_ai<State>(players[0], players[1], game_number);
+}
+
 } // namespace play
\ No newline at end of file
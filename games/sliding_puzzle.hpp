@@ -0,0 +1,598 @@
+/*
+W x H のスライディングパズル (8 パズル, 15 パズル, 24 パズルなど)
+終端状態はセル i にコマ i + 1 を置き, 右下のセルを空白 (0) とする
+セル番号は左上から右へ 0, 1, ..., W * H - 1 とする
+終端位置, 移動先のセル, マンハッタン距離, linear conflict の表は, 盤面の大きさごとにコンパイル時に作る
+盤面の詰め方は大きさで特殊化する
+  16 セル以下 : 4 ビット × セル数 を 64 ビット整数に詰める. ハッシュ値は盤面からの全単射なので衝突しない
+  25 セル以下 : 5 ビット × セル数 を 128 ビット整数に詰める. ハッシュ値は 64 ビットに畳み込むので衝突しうる
+                (ハッシュ値の衝突が無いことを前提とする A* 探索ではなく, 反復深化 A* 探索で解く)
+4x4 の状態は games/fifteen_puzzle でも使い, walking distance やパターンデータベースなどの専用の h コストはそちらにある
+テンプレートを使用するためにヘッダに実装を書いている
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace sliding_puzzle {
+
+using HashValue = uint64_t;
+
+// MurmurHash3 の fmix64 (全単射)
+constexpr uint64_t mix64(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCD;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53;
+    value ^= value >> 33;
+    return value;
+}
+
+// 盤面の詰め方. セル数で特殊化する
+template <int CellCount, bool IsSmall = (CellCount <= 16)>
+struct Packing;
+
+// 4 ビット × 16 セル以下
+template <int CellCount>
+struct Packing<CellCount, true> {
+    using Board = uint64_t;
+
+    static constexpr int BITS = 4;
+    static constexpr int MASK = 0xF;
+
+    static constexpr int get(const Board board, const int index) {
+        return static_cast<int>(board >> (index * BITS)) & MASK;
+    }
+
+    static constexpr Board at(const int value, const int index) {
+        return Board(value) << (index * BITS);
+    }
+
+    static constexpr HashValue hash(const Board board) {
+        return mix64(board);
+    }
+};
+
+// 5 ビット × 25 セル以下
+template <int CellCount>
+struct Packing<CellCount, false> {
+    static_assert(CellCount <= 25, "sliding_puzzle supports at most 25 cells");
+
+    using Board = unsigned __int128;
+
+    static constexpr int BITS = 5;
+    static constexpr int MASK = 0x1F;
+
+    static constexpr int get(const Board board, const int index) {
+        return static_cast<int>(board >> (index * BITS)) & MASK;
+    }
+
+    static constexpr Board at(const int value, const int index) {
+        return Board(value) << (index * BITS);
+    }
+
+    static constexpr HashValue hash(const Board board) {
+        return mix64(static_cast<uint64_t>(board) ^ mix64(static_cast<uint64_t>(board >> 64)));
+    }
+};
+
+// 幅 W の盤面で, cell 番号から座標 (行, 列) を取得
+template <int W>
+constexpr std::pair<int, int> get_coordinate(const int cell) {
+    return {cell / W, cell % W};
+}
+
+// 盤面の大きさごとの表
+template <int W, int H>
+struct Geometry {
+    static constexpr int WIDTH = W;
+    static constexpr int HEIGHT = H;
+    static constexpr int CELL_COUNT = W * H;
+
+    using Pack = Packing<CELL_COUNT>;
+    using Board = typename Pack::Board;
+
+    static constexpr std::pair<int, int> get_coordinate(const int cell) {
+        return sliding_puzzle::get_coordinate<W>(cell);
+    }
+
+    // インデックスがコマ番号, 値がセル番号
+    static constexpr auto terminal_positions = [] {
+        std::array<int, CELL_COUNT> positions{};
+        positions[0] = CELL_COUNT - 1;
+        for (int number = 1; number < CELL_COUNT; ++number) {
+            positions[number] = number - 1;
+        }
+        return positions;
+    }();
+
+    // 終端状態の, インデックスがセル番号, 値がコマ番号の盤面
+    static constexpr Board TERMINAL_BOARD = [] {
+        Board board = 0;
+        for (int number = 1; number < CELL_COUNT; ++number) {
+            board |= Pack::at(number, terminal_positions[number]);
+        }
+        return board;
+    }();
+
+    // neighbors[セル番号][action] : 空白が action の方向 (0: 左, 1: 右, 2: 上, 3: 下) に動いた先のセル番号. 動けなければ -1
+    static constexpr auto neighbors = [] {
+        std::array<std::array<int, 4>, CELL_COUNT> cells{};
+        for (int cell = 0; cell < CELL_COUNT; ++cell) {
+            const auto [h, w] = sliding_puzzle::get_coordinate<W>(cell);
+            cells[cell] = {w > 0 ? cell - 1 : -1, w + 1 < W ? cell + 1 : -1, h > 0 ? cell - W : -1, h + 1 < H ? cell + W : -1};
+        }
+        return cells;
+    }();
+
+    // manhattan_distances[コマ番号][セル番号] : コマがセルにあるときの終端位置までのマンハッタン距離. 空白は 0
+    static constexpr auto manhattan_distances = [] {
+        std::array<std::array<int, CELL_COUNT>, CELL_COUNT> distances{};
+        for (int number = 1; number < CELL_COUNT; ++number) {
+            const auto [terminal_h, terminal_w] = get_coordinate(terminal_positions[number]);
+            for (int cell = 0; cell < CELL_COUNT; ++cell) {
+                const auto [h, w] = get_coordinate(cell);
+                distances[number][cell] = (h > terminal_h ? h - terminal_h : terminal_h - h) + (w > terminal_w ? w - terminal_w : terminal_w - w);
+            }
+        }
+        return distances;
+    }();
+};
+
+// line_conflicts<L>[並びの状態] : 長さ L の行 (列) の各セルについて, 終端がその行 (列) のコマなら終端での位置 (0 ~ L - 1),
+// そうでなければ L とした (L + 1) 進数に対する linear conflict (逆順の組を無くすために取り除くコマの最小数の 2 倍)
+template <int L>
+inline constexpr auto line_conflicts = [] {
+    constexpr int BASE = L + 1;
+    constexpr int SIZE = [] {
+        int size = 1;
+        for (int i = 0; i < L; ++i) {
+            size *= BASE;
+        }
+        return size;
+    }();
+    std::array<uint8_t, SIZE> conflicts{};
+    for (int line = 0; line < SIZE; ++line) {
+        int sequence[L] = {};
+        int length = 0;
+        for (int i = 0, code = line; i < L; ++i, code /= BASE) {
+            if (code % BASE != L) {
+                sequence[length++] = code % BASE;
+            }
+        }
+        // 最長増加部分列
+        int longest[L] = {};
+        int max_longest = 0;
+        for (int i = 0; i < length; ++i) {
+            longest[i] = 1;
+            for (int j = 0; j < i; ++j) {
+                if (sequence[j] < sequence[i] && longest[j] + 1 > longest[i]) {
+                    longest[i] = longest[j] + 1;
+                }
+            }
+            max_longest = longest[i] > max_longest ? longest[i] : max_longest;
+        }
+        conflicts[line] = static_cast<uint8_t>(2 * (length - max_longest));
+    }
+    return conflicts;
+}();
+
+// h コストの方針 (盤面の大きさ Geometry を受け取る. games/fifteen_puzzle の 4x4 専用の方針も同じ形で書く)
+// Data は状態ごとに持つ差分更新用の情報
+// initialize は盤面全体から Data を作って h コストを返す
+// update は number のコマがセル from から to に動いた後に呼ばれ, h コストの変化量を返す. before, after は動かす前後の盤面
+namespace heuristic {
+
+// 各コマの終端までのマンハッタン距離の合計
+template <class Geometry>
+struct Manhattan {
+    using Board = typename Geometry::Board;
+
+    struct Data {};
+
+    static int initialize(Data&, const Board, const Board positions) {
+        int h_cost = 0;
+        for (int number = 1; number < Geometry::CELL_COUNT; ++number) {
+            h_cost += Geometry::manhattan_distances[number][Geometry::Pack::get(positions, number)];
+        }
+        return h_cost;
+    }
+
+    static int update(Data&, const Board, const Board, const int number, const int from, const int to) {
+        return Geometry::manhattan_distances[number][to] - Geometry::manhattan_distances[number][from];
+    }
+};
+
+// マンハッタン距離に linear conflict を加えたもの
+template <class Geometry>
+struct LinearConflict {
+    using Board = typename Geometry::Board;
+    using Data = typename Manhattan<Geometry>::Data;
+
+    static constexpr int W = Geometry::WIDTH;
+    static constexpr int H = Geometry::HEIGHT;
+
+    // row_digits[行][コマ番号] : 行の並びの状態でのそのコマの桁. column_digits も同様
+    static constexpr auto row_digits = [] {
+        std::array<std::array<int, Geometry::CELL_COUNT>, H> digits{};
+        for (int row = 0; row < H; ++row) {
+            for (int number = 0; number < Geometry::CELL_COUNT; ++number) {
+                const auto [terminal_h, terminal_w] = Geometry::get_coordinate(Geometry::terminal_positions[number]);
+                digits[row][number] = number != 0 && terminal_h == row ? terminal_w : W;
+            }
+        }
+        return digits;
+    }();
+
+    static constexpr auto column_digits = [] {
+        std::array<std::array<int, Geometry::CELL_COUNT>, W> digits{};
+        for (int column = 0; column < W; ++column) {
+            for (int number = 0; number < Geometry::CELL_COUNT; ++number) {
+                const auto [terminal_h, terminal_w] = Geometry::get_coordinate(Geometry::terminal_positions[number]);
+                digits[column][number] = number != 0 && terminal_w == column ? terminal_h : H;
+            }
+        }
+        return digits;
+    }();
+
+    static int row_conflict(const Board numbers, const int row) {
+        int code = 0;
+        for (int w = W - 1; w >= 0; --w) {
+            code = code * (W + 1) + row_digits[row][Geometry::Pack::get(numbers, row * W + w)];
+        }
+        return line_conflicts<W>[code];
+    }
+
+    static int column_conflict(const Board numbers, const int column) {
+        int code = 0;
+        for (int h = H - 1; h >= 0; --h) {
+            code = code * (H + 1) + column_digits[column][Geometry::Pack::get(numbers, h * W + column)];
+        }
+        return line_conflicts<H>[code];
+    }
+
+    static int initialize(Data& data, const Board numbers, const Board positions) {
+        int h_cost = Manhattan<Geometry>::initialize(data, numbers, positions);
+        for (int row = 0; row < H; ++row) {
+            h_cost += row_conflict(numbers, row);
+        }
+        for (int column = 0; column < W; ++column) {
+            h_cost += column_conflict(numbers, column);
+        }
+        return h_cost;
+    }
+
+    // 横に動けば, そのコマの行の並び順は変わらず, 移動元と移動先の列だけが変わる (縦も同様)
+    static int update(Data& data, const Board before, const Board after, const int number, const int from, const int to) {
+        const int manhattan = Manhattan<Geometry>::update(data, before, after, number, from, to);
+        if (from / W != to / W) {
+            const int from_row = from / W;
+            const int to_row = to / W;
+            return manhattan + row_conflict(after, from_row) + row_conflict(after, to_row) - row_conflict(before, from_row) - row_conflict(before, to_row);
+        }
+        const int from_column = from % W;
+        const int to_column = to % W;
+        return manhattan + column_conflict(after, from_column) + column_conflict(after, to_column)
+            - column_conflict(before, from_column) - column_conflict(before, to_column);
+    }
+};
+
+} // namespace heuristic
+
+template <int W, int H, template <class> class Heuristic = heuristic::Manhattan>
+class BasicSlidingPuzzleState {
+public:
+    using Geometry = sliding_puzzle::Geometry<W, H>;
+    using Pack = typename Geometry::Pack;
+    using Board = typename Geometry::Board;
+    using HeuristicPolicy = Heuristic<Geometry>;
+
+    static constexpr int CELL_COUNT = Geometry::CELL_COUNT;
+    static constexpr int ACTION_COUNT = 4;
+
+    int turn = 0;
+    int g_cost = 0;
+    int h_cost = 0;
+    // 16 セル以下なら盤面と 1 対 1 に対応する
+    HashValue hash_value = 0;
+
+    // numbers[セル番号] = コマ番号 の盤面から作る. 解けない配置かどうかは確かめない
+    explicit BasicSlidingPuzzleState(const std::array<int, CELL_COUNT>& numbers);
+
+    // 終端状態から, 直前の手を取り消さないランダムなスライドを move_count 回行った盤面から作る
+    BasicSlidingPuzzleState(std::mt19937_64& engine, const int move_count);
+
+    // step(action, undo_info) で保存する, 動かす前の h コストとハッシュ値
+    // undo(action, undo_info) は盤面を戻すだけで h コストを計算し直さない
+    struct UndoInfo {
+        int h_cost;
+        HashValue hash_value;
+        [[no_unique_address]] typename HeuristicPolicy::Data heuristic_data;
+    };
+
+    // action は 0: 左, 1: 右, 2: 上, 3: 下 (空白を動かす向き)
+    void step(const int action);
+
+    void step(const int action, UndoInfo& undo_info);
+
+    // step(action) の直後に呼ぶと, その手を取り消す
+    void undo(const int action);
+
+    // step(action, undo_info) の直後に呼ぶと, その手を取り消す
+    void undo(const int action, const UndoInfo& undo_info);
+
+    bool is_done() const;
+
+    std::vector<int> legal_actions() const;
+
+    bool is_legal_action(const int action) const;
+
+    // 盤面全体から h コストを計算し直す. step では差分だけ更新するので, 検算用
+    int compute_h_cost() const;
+
+    int get_f_cost() const;
+
+    // インデックスがセル番号, 値がコマ番号の盤面
+    Board packed_board() const;
+
+    // インデックスがコマ番号, 値がセル番号の盤面
+    Board packed_positions() const;
+
+    // numbers[セル番号] = コマ番号 の盤面 (別の Heuristic の状態を作るときに使う)
+    std::array<int, CELL_COUNT> board() const;
+
+    // action と逆向きの行動 (左右, 上下を入れ替える)
+    static constexpr int inverse_action(const int action) {
+        return action ^ 1;
+    }
+
+    template <int W2, int H2, template <class> class H3>
+    friend std::ostream& operator<<(std::ostream& os, const BasicSlidingPuzzleState<W2, H2, H3>& state);
+
+private:
+    // セル → コマ番号
+    Board numbers_ = 0;
+    // コマ番号 → セル
+    Board positions_ = 0;
+    [[no_unique_address]] typename HeuristicPolicy::Data heuristic_data_{};
+
+    void initialize(const std::array<int, CELL_COUNT>& numbers);
+
+    // 空白を action の方向に動かし, h コストとハッシュ値を更新する
+    void slide(const int action);
+
+    // 空白を action の方向に動かし, 動いたコマの番号を返す. from, to にはそのコマの移動元と移動先のセルを入れる
+    int move_blank(const int action, int& from, int& to);
+};
+
+template <int W, int H, template <class> class Heuristic>
+BasicSlidingPuzzleState<W, H, Heuristic>::BasicSlidingPuzzleState(const std::array<int, CELL_COUNT>& numbers) {
+    initialize(numbers);
+}
+
+template <int W, int H, template <class> class Heuristic>
+BasicSlidingPuzzleState<W, H, Heuristic>::BasicSlidingPuzzleState(std::mt19937_64& engine, const int move_count) {
+    std::array<int, CELL_COUNT> numbers;
+    for (int number = 0; number < CELL_COUNT; ++number) {
+        numbers[Geometry::terminal_positions[number]] = number;
+    }
+    initialize(numbers);
+    int pre_action = -1;
+    for (int t = 0; t < move_count; ++t) {
+        std::vector<int> actions;
+        for (const auto action : legal_actions()) {
+            if (pre_action < 0 || action != inverse_action(pre_action)) {
+                actions.emplace_back(action);
+            }
+        }
+        pre_action = actions[engine() % actions.size()];
+        slide(pre_action);
+    }
+}
+
+template <int W, int H, template <class> class Heuristic>
+void BasicSlidingPuzzleState<W, H, Heuristic>::initialize(const std::array<int, CELL_COUNT>& numbers) {
+    numbers_ = 0;
+    positions_ = 0;
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+        numbers_ |= Pack::at(numbers[cell], cell);
+        positions_ |= Pack::at(cell, numbers[cell]);
+    }
+    h_cost = HeuristicPolicy::initialize(heuristic_data_, numbers_, positions_);
+    hash_value = Pack::hash(numbers_);
+}
+
+template <int W, int H, template <class> class Heuristic>
+inline void BasicSlidingPuzzleState<W, H, Heuristic>::step(const int action) {
+    slide(action);
+    ++turn;
+    ++g_cost;
+}
+
+template <int W, int H, template <class> class Heuristic>
+inline void BasicSlidingPuzzleState<W, H, Heuristic>::undo(const int action) {
+    slide(inverse_action(action));
+    --turn;
+    --g_cost;
+}
+
+template <int W, int H, template <class> class Heuristic>
+inline void BasicSlidingPuzzleState<W, H, Heuristic>::step(const int action, UndoInfo& undo_info) {
+    undo_info = {h_cost, hash_value, heuristic_data_};
+    step(action);
+}
+
+template <int W, int H, template <class> class Heuristic>
+inline void BasicSlidingPuzzleState<W, H, Heuristic>::undo(const int action, const UndoInfo& undo_info) {
+    int from, to;
+    move_blank(inverse_action(action), from, to);
+    h_cost = undo_info.h_cost;
+    hash_value = undo_info.hash_value;
+    heuristic_data_ = undo_info.heuristic_data;
+    --turn;
+    --g_cost;
+}
+
+template <int W, int H, template <class> class Heuristic>
+inline int BasicSlidingPuzzleState<W, H, Heuristic>::move_blank(const int action, int& from, int& to) {
+    const int zero = Pack::get(positions_, 0);
+    const int moved_zero = Geometry::neighbors[zero][action];
+    // 空白を動かした先にあるコマの番号
+    const int number = Pack::get(numbers_, moved_zero);
+    // 空白のセルの値は 0 なので, コマを書き込んでから移動元を消せばよい
+    numbers_ |= Pack::at(number, zero);
+    numbers_ &= ~Pack::at(Pack::MASK, moved_zero);
+    // コマと空白のセル番号を入れ替える
+    const int diff = zero ^ moved_zero;
+    positions_ ^= Pack::at(diff, 0) | Pack::at(diff, number);
+    from = moved_zero;
+    to = zero;
+    return number;
+}
+
+template <int W, int H, template <class> class Heuristic>
+inline void BasicSlidingPuzzleState<W, H, Heuristic>::slide(const int action) {
+    const Board before = numbers_;
+    int from, to;
+    const int number = move_blank(action, from, to);
+    h_cost += HeuristicPolicy::update(heuristic_data_, before, numbers_, number, from, to);
+    hash_value = Pack::hash(numbers_);
+}
+
+template <int W, int H, template <class> class Heuristic>
+inline bool BasicSlidingPuzzleState<W, H, Heuristic>::is_done() const {
+    return numbers_ == Geometry::TERMINAL_BOARD;
+}
+
+template <int W, int H, template <class> class Heuristic>
+std::vector<int> BasicSlidingPuzzleState<W, H, Heuristic>::legal_actions() const {
+    std::vector<int> actions;
+    const auto& neighbors = Geometry::neighbors[Pack::get(positions_, 0)];
+    for (int action = 0; action < ACTION_COUNT; ++action) {
+        if (neighbors[action] >= 0) {
+            actions.emplace_back(action);
+        }
+    }
+    return actions;
+}
+
+template <int W, int H, template <class> class Heuristic>
+inline bool BasicSlidingPuzzleState<W, H, Heuristic>::is_legal_action(const int action) const {
+    return Geometry::neighbors[Pack::get(positions_, 0)][action] >= 0;
+}
+
+template <int W, int H, template <class> class Heuristic>
+int BasicSlidingPuzzleState<W, H, Heuristic>::compute_h_cost() const {
+    typename HeuristicPolicy::Data data{};
+    return HeuristicPolicy::initialize(data, numbers_, positions_);
+}
+
+template <int W, int H, template <class> class Heuristic>
+inline int BasicSlidingPuzzleState<W, H, Heuristic>::get_f_cost() const {
+    return g_cost + h_cost;
+}
+
+template <int W, int H, template <class> class Heuristic>
+inline auto BasicSlidingPuzzleState<W, H, Heuristic>::packed_board() const -> Board {
+    return numbers_;
+}
+
+template <int W, int H, template <class> class Heuristic>
+inline auto BasicSlidingPuzzleState<W, H, Heuristic>::packed_positions() const -> Board {
+    return positions_;
+}
+
+template <int W, int H, template <class> class Heuristic>
+auto BasicSlidingPuzzleState<W, H, Heuristic>::board() const -> std::array<int, CELL_COUNT> {
+    std::array<int, CELL_COUNT> numbers;
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+        numbers[cell] = Pack::get(numbers_, cell);
+    }
+    return numbers;
+}
+
+// ゲーム状況の出力
+template <int W, int H, template <class> class Heuristic>
+std::ostream& operator<<(std::ostream& os, const BasicSlidingPuzzleState<W, H, Heuristic>& state) {
+    using Pack = typename BasicSlidingPuzzleState<W, H, Heuristic>::Pack;
+    os << "Turn\t" << state.turn << "\tg cost\t" << state.g_cost << "\th cost\t" << state.h_cost << "\tf cost\t" << state.get_f_cost() << '\n';
+    for (int h = 0; h < H; ++h) {
+        if (h) {
+            for (int w = 0; w < W; ++w) {
+                os << (w ? " + --" : "--");
+            }
+            os << '\n';
+        }
+        for (int w = 0; w < W; ++w) {
+            if (w) {
+                os << " | ";
+            }
+            os << std::setw(2) << Pack::get(state.numbers_, h * W + w);
+        }
+        os << '\n';
+    }
+    return os;
+}
+
+template <int W, int H>
+using State = BasicSlidingPuzzleState<W, H>;
+
+using EightPuzzleState = BasicSlidingPuzzleState<3, 3>;
+using FifteenPuzzleState = BasicSlidingPuzzleState<4, 4>;
+using TwentyFourPuzzleState = BasicSlidingPuzzleState<5, 5, heuristic::LinearConflict>;
+
+// numbers[セル番号] = コマ番号 の盤面を終端状態まで動かせるか
+// 終端状態からの置換 (空白を含む) の偶奇が, 空白の終端位置までのマンハッタン距離の偶奇と一致すれば解ける
+template <int W, int H>
+bool is_solvable(const std::array<int, W * H>& numbers) {
+    using G = Geometry<W, H>;
+    bool is_odd = false;
+    std::array<bool, W * H> visited{};
+    for (int cell = 0; cell < G::CELL_COUNT; ++cell) {
+        int length = 0;
+        for (int c = cell; !visited[c]; c = G::terminal_positions[numbers[c]]) {
+            visited[c] = true;
+            ++length;
+        }
+        if (length > 0 && length % 2 == 0) {
+            is_odd = !is_odd;
+        }
+    }
+    int zero_cell = 0;
+    while (numbers[zero_cell] != 0) {
+        ++zero_cell;
+    }
+    const auto [h, w] = G::get_coordinate(zero_cell);
+    const auto [terminal_h, terminal_w] = G::get_coordinate(G::terminal_positions[0]);
+    const int distance = (h > terminal_h ? h - terminal_h : terminal_h - h) + (w > terminal_w ? w - terminal_w : terminal_w - w);
+    return is_odd == (distance % 2 == 1);
+}
+
+// 解ける盤面の中から一様に 1 つ選ぶ
+// コマを一様に並べ替え, 解けなければ空白以外の 2 枚を入れ替える (解けない盤面と解ける盤面が 1 対 1 に対応する)
+template <int W, int H>
+std::array<int, W * H> random_board(std::mt19937_64& engine) {
+    std::array<int, W * H> numbers;
+    for (int cell = 0; cell < W * H; ++cell) {
+        numbers[cell] = cell;
+    }
+    // std::shuffle は実装ごとに結果が異なるので, シードから同じ盤面を再現できるように自前で並べ替える
+    for (int cell = W * H - 1; cell > 0; --cell) {
+        std::swap(numbers[cell], numbers[engine() % (cell + 1)]);
+    }
+    if (!is_solvable<W, H>(numbers)) {
+        const int first = numbers[0] == 0 ? 1 : 0;
+        const int second = numbers[first + 1] == 0 ? first + 2 : first + 1;
+        std::swap(numbers[first], numbers[second]);
+    }
+    return numbers;
+}
+
+} // namespace sliding_puzzle
@@ -1,37 +1,30 @@
 #include "tic_tac_toe.hpp"
 
+#include <bit>
 #include <random>
 
 namespace tic_tac_toe {
 
-namespace zobrist_hashing {
-
-HashMap make_hash_map() {
-    static std::mt19937 engine{std::random_device()()};
-    HashMap hash_map;
-    BitBoard piece = 1;
-    for (int h = 0; h < 3; ++h) {
-        for (int w = 0; w < 3; ++w) {
-            hash_map[piece] = engine();
-            piece <<= 1;
-        }
-        piece <<= 1;
-    }
-    return hash_map;
-}
-
-} // namespace zobrist_hashing
-
-zobrist_hashing::HashMap TicTacToeState::hash_maps[2] = {zobrist_hashing::make_hash_map(), zobrist_hashing::make_hash_map()};
-
 void TicTacToeState::step(const BitBoard action) {
     player_position_ ^= action;
-    hash_value ^= hash_maps[!is_black_turn][action];
+    hash_value ^= zobrist_hashing::keys[!is_black_turn][std::countr_zero(action)];
     std::swap(player_position_, opponent_position_);
     ++turn;
     is_black_turn = !is_black_turn;
 }
 
+void TicTacToeState::step(const BitBoard action, UndoInfo&) {
+    step(action);
+}
+
+void TicTacToeState::undo(const BitBoard action, const UndoInfo) {
+    is_black_turn = !is_black_turn;
+    --turn;
+    std::swap(player_position_, opponent_position_);
+    hash_value ^= zobrist_hashing::keys[!is_black_turn][std::countr_zero(action)];
+    player_position_ ^= action;
+}
+
 std::vector<BitBoard> TicTacToeState::legal_actions() const {
     std::vector<BitBoard> actions;
     BitBoard pieces = cells_can_put();
@@ -92,6 +85,10 @@ std::ostream& operator<<(std::ostream& os, const TicTacToeState& state) {
 
 Action random_action(const State& state) {
     static std::mt19937 engine{std::random_device()()};
+    return random_action(state, engine);
+}
+
+Action random_action(const State& state, std::mt19937& engine) {
     const auto legal_actions = state.legal_actions();
     return legal_actions[engine() % legal_actions.size()];
 }
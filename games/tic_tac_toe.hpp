@@ -1,15 +1,18 @@
 /*
 三目並べの実装
-zobrist hashing 付き
+zobrist hashing 付き. 乱数表はコンパイル時に生成する
 */
 
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <ostream>
-#include <unordered_map>
+#include <random>
 #include <vector>
 
 #include "play.hpp"
+#include "../utils/zobrist_hashing.hpp"
 
 namespace tic_tac_toe {
 
@@ -18,15 +21,18 @@ constexpr BitBoard FULL_POS = 0x0777;
 
 namespace zobrist_hashing {
 
-using HashValue = uint64_t;
-using HashMap = std::unordered_map<BitBoard, HashValue>;
+using HashValue = ::zobrist_hashing::HashValue;
 
-HashMap make_hash_map();
+// keys[後手なら 1][コマを置くビットの位置]
+inline constexpr auto keys = ::zobrist_hashing::make_key_table<2, 16>(0x7469635F7461635F);
 
 } // namespace zobrist_hashing
 
 class TicTacToeState {
 public:
+    // 置いたマスだけで手を取り消せるので, 記録するものは無い
+    struct UndoInfo {};
+
     unsigned int turn = 0;
     bool is_black_turn = 1;
 
@@ -34,17 +40,22 @@ public:
 
     void step(const BitBoard action);
 
+    void step(const BitBoard action, UndoInfo& undo_info);
+
+    // step の直後に呼ぶと, その手を取り消す
+    void undo(const BitBoard action, const UndoInfo undo_info = {});
+
     bool is_done() const;
 
     std::vector<BitBoard> legal_actions() const;
 
     WinningStatus get_winning_status() const;
 
+    std::size_t position_index() const;
+
     friend std::ostream& operator<<(std::ostream& os, const TicTacToeState& state);
 
 private:
-    static zobrist_hashing::HashMap hash_maps[2];
-
     BitBoard player_position_ = 0;
     BitBoard opponent_position_ = 0;
 
@@ -97,9 +108,40 @@ inline BitBoard TicTacToeState::cells_can_put() const {
     return ~(player_position_ | opponent_position_) & FULL_POS;
 }
 
+// 4 ビット刻みの BitBoard から 9 マス分のビットを詰めて取り出す
+inline unsigned int compress_position(const BitBoard position) {
+    return (position & 0x7) | ((position >> 1) & 0x38) | ((position >> 2) & 0x1C0);
+}
+
+// 9 ビットのマスクを, 立っているビットの桁が 1 の 3 進数に変換する表
+inline constexpr auto base3_table = [] {
+    std::array<unsigned short, 512> table{};
+    for (unsigned int mask = 0; mask < 512; ++mask) {
+        unsigned int power = 1;
+        for (int cell = 0; cell < 9; ++cell) {
+            if (mask >> cell & 1) {
+                table[mask] += power;
+            }
+            power *= 3;
+        }
+    }
+    return table;
+}();
+
+// 盤面の 3 進数表現. セル番号 h * 3 + w の桁が 0: 空き, 1: 先手のコマ, 2: 後手のコマ
+// 手番はコマ数から決まるので, 到達可能な局面と 0 以上 3^9 未満の整数が 1 対 1 に対応する
+inline std::size_t TicTacToeState::position_index() const {
+    const BitBoard black_position = is_black_turn ? player_position_ : opponent_position_;
+    const BitBoard white_position = is_black_turn ? opponent_position_ : player_position_;
+    return base3_table[compress_position(black_position)] + 2 * base3_table[compress_position(white_position)];
+}
+
 using State = TicTacToeState;
 using Action = BitBoard;
 
 Action random_action(const State& state);
 
+// engine で手を選ぶ. 対局ごとに種を決めた engine を渡せば, 同じ対局を再現できる
+Action random_action(const State& state, std::mt19937& engine);
+
 } // namespace tic_tac_toe
\ No newline at end of file
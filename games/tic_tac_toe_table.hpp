@@ -0,0 +1,106 @@
+/*
+三目並べの完全解析表
+すべての盤面 (3^9 通り) の勝敗と最善手を, コンパイル時に後退解析で求める
+インデックスは TicTacToeState::position_index で, 子の局面は必ず親より大きいインデックスを持つので
+インデックスの大きい順に 1 回走査するだけで解析が終わる
+*/
+
+#pragma once
+
+#include <array>
+#include <bit>
+
+#include "tic_tac_toe.hpp"
+
+namespace tic_tac_toe::perfect_play {
+
+// value: 手番側から見た勝敗 (1: 勝ち, 0: 引き分け, -1: 負け)
+// best_cell: 最善手のセル番号 (h * 3 + w). 終端局面や到達不能な局面では 9
+struct Entry {
+    signed char value;
+    unsigned char best_cell;
+};
+
+inline constexpr std::size_t TABLE_SIZE = 19683;  // 3^9
+
+// 9 ビットのマスク上で 3 つ並んでいるか
+constexpr bool has_three_sequences(const unsigned int mask) {
+    constexpr unsigned int lines[8] = {0007, 0070, 0700, 0111, 0222, 0444, 0421, 0124};
+    for (const auto line : lines) {
+        if ((mask & line) == line) {
+            return true;
+        }
+    }
+    return false;
+}
+
+constexpr std::array<Entry, TABLE_SIZE> make_table() {
+    std::array<Entry, TABLE_SIZE> table{};
+    unsigned int powers[9] = {};
+    powers[0] = 1;
+    for (int cell = 1; cell < 9; ++cell) {
+        powers[cell] = powers[cell - 1] * 3;
+    }
+    for (int index = TABLE_SIZE - 1; index >= 0; --index) {
+        table[index] = {0, 9};
+        unsigned int black_mask = 0;
+        unsigned int white_mask = 0;
+        for (int cell = 0, rest = index; cell < 9; ++cell, rest /= 3) {
+            if (rest % 3 == 1) {
+                black_mask |= 1u << cell;
+            } else if (rest % 3 == 2) {
+                white_mask |= 1u << cell;
+            }
+        }
+        const int black_count = std::popcount(black_mask);
+        const int white_count = std::popcount(white_mask);
+        if (black_count != white_count && black_count != white_count + 1) {
+            continue;
+        }
+        const bool is_black_turn = black_count == white_count;
+        const unsigned int player_mask = is_black_turn ? black_mask : white_mask;
+        const unsigned int opponent_mask = is_black_turn ? white_mask : black_mask;
+        if (has_three_sequences(opponent_mask)) {
+            table[index].value = -1;
+            continue;
+        }
+        if (has_three_sequences(player_mask)) {
+            table[index].value = 1;
+            continue;
+        }
+        const unsigned int empty_mask = ~(black_mask | white_mask) & 0777;
+        if (!empty_mask) {
+            continue;
+        }
+        table[index].value = -2;
+        for (int cell = 0; cell < 9; ++cell) {
+            if (empty_mask >> cell & 1) {
+                const int value = -table[index + powers[cell] * (is_black_turn ? 1 : 2)].value;
+                if (value > table[index].value) {
+                    table[index] = {static_cast<signed char>(value), static_cast<unsigned char>(cell)};
+                }
+            }
+        }
+    }
+    return table;
+}
+
+inline constexpr auto table = make_table();
+
+// 初期局面は引き分け
+static_assert(table[0].value == 0);
+
+inline Action cell_to_action(const int cell) {
+    return static_cast<Action>(1 << ((cell / 3) * 4 + cell % 3));
+}
+
+inline int get_value(const State& state) {
+    return table[state.position_index()].value;
+}
+
+// O(1) で最善手を返す
+inline Action best_action(const State& state) {
+    return cell_to_action(table[state.position_index()].best_cell);
+}
+
+} // namespace tic_tac_toe::perfect_play
@@ -0,0 +1,139 @@
+/*
+節点をプールに確保する A* 探索
+生成した状態は 1 本の配列 (プール) に追加し, 親は 32 ビットの添字で指す
+open リストは f コストのバケットキュー (同じ f なら g の大きい順), closed リストは状態のハッシュ値から
+その状態の最良の節点の添字を引く 1 つのハッシュ表で管理する
+より小さい g で再び生成された状態は新しい節点として追加し, 古い節点は取り出したときに読み飛ばす
+
+状態は step, legal_actions, is_done と, step で更新されるメンバ変数 g_cost, hash_value を持てばよい
+h コストは Heuristic で計算する (既定では状態のメンバ変数 h_cost)
+hash_value は状態と 1 対 1 に対応する (衝突しない) ことを前提とする
+テンプレートを使用するためにヘッダに実装を書いている
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "bucket_queue.hpp"
+#include "flat_hash_map.hpp"
+
+namespace a_star {
+
+using NodeIndex = uint32_t;
+
+static constexpr NodeIndex NO_PARENT = UINT32_MAX;
+
+// 状態が持つ h コストをそのまま使う
+struct StateHeuristic {
+    template <class State>
+    int operator()(const State& state) const {
+        return state.h_cost;
+    }
+};
+
+template <class State>
+struct Node {
+    State state;
+    NodeIndex parent;
+};
+
+template <class State, class Heuristic = StateHeuristic>
+class Solver {
+public:
+    explicit Solver(Heuristic heuristic = Heuristic()) : heuristic_(heuristic) {}
+
+    // 初期状態からゴールまでの最短経路 (初期状態とゴールを含む) を返す. 解が無ければ空
+    std::vector<State> solve(const State& initial_state);
+
+    // 直前の solve で展開した節点数
+    int64_t expanded_count() const;
+
+    // 直前の solve で生成した節点数 (プールの大きさ)
+    std::size_t node_count() const;
+
+    // プール, キュー, ハッシュ表の使用メモリ (バイト)
+    std::size_t size_in_bytes() const;
+
+private:
+    Heuristic heuristic_;
+    std::vector<Node<State>> nodes_;
+    BucketQueue<NodeIndex> frontier_;
+    // 状態のハッシュ値 -> 最良の節点の添字
+    FlatHashMap<NodeIndex> best_nodes_;
+    int64_t expanded_count_ = 0;
+
+    NodeIndex add_node(const State& state, const NodeIndex parent);
+
+    std::vector<State> get_shortest_path(NodeIndex index) const;
+};
+
+template <class State, class Heuristic>
+inline NodeIndex Solver<State, Heuristic>::add_node(const State& state, const NodeIndex parent) {
+    const auto index = static_cast<NodeIndex>(nodes_.size());
+    nodes_.push_back({state, parent});
+    best_nodes_[state.hash_value] = index;
+    frontier_.push(state.g_cost + heuristic_(state), state.g_cost, index);
+    return index;
+}
+
+template <class State, class Heuristic>
+std::vector<State> Solver<State, Heuristic>::solve(const State& initial_state) {
+    nodes_.clear();
+    frontier_.clear();
+    best_nodes_.clear();
+    expanded_count_ = 0;
+    add_node(initial_state, NO_PARENT);
+    while (!frontier_.empty()) {
+        const NodeIndex index = frontier_.pop();
+        // より小さい g で生成し直された状態の古い節点は飛ばす
+        if (*best_nodes_.find(nodes_[index].state.hash_value) != index) {
+            continue;
+        }
+        if (nodes_[index].state.is_done()) {
+            return get_shortest_path(index);
+        }
+        ++expanded_count_;
+        // add_node でプールが再確保されると参照が無効になるので, 状態をコピーしておく
+        const State state = nodes_[index].state;
+        for (const auto action : state.legal_actions()) {
+            State next_state = state;
+            next_state.step(action);
+            if (const auto* best = best_nodes_.find(next_state.hash_value); best != nullptr && nodes_[*best].state.g_cost <= next_state.g_cost) {
+                continue;
+            }
+            add_node(next_state, index);
+        }
+    }
+    return {};
+}
+
+template <class State, class Heuristic>
+std::vector<State> Solver<State, Heuristic>::get_shortest_path(NodeIndex index) const {
+    std::vector<State> shortest_path;
+    for (; index != NO_PARENT; index = nodes_[index].parent) {
+        shortest_path.emplace_back(nodes_[index].state);
+    }
+    std::reverse(shortest_path.begin(), shortest_path.end());
+    return shortest_path;
+}
+
+template <class State, class Heuristic>
+inline int64_t Solver<State, Heuristic>::expanded_count() const {
+    return expanded_count_;
+}
+
+template <class State, class Heuristic>
+inline std::size_t Solver<State, Heuristic>::node_count() const {
+    return nodes_.size();
+}
+
+template <class State, class Heuristic>
+inline std::size_t Solver<State, Heuristic>::size_in_bytes() const {
+    return nodes_.capacity() * sizeof(Node<State>) + frontier_.size() * sizeof(NodeIndex) + best_nodes_.size_in_bytes();
+}
+
+} // namespace a_star
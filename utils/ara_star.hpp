@@ -0,0 +1,347 @@
+/*
+重み付き A* 探索と ARA* (Anytime Repairing A*)
+優先度を g + w * h (w >= 1) とすると, 見つかる解の長さは最短経路の長さの w 倍以下になる
+ARA* は w を段階的に下げながら探索を繰り返し, より良い解とその最適性の上界を順に報告する
+  ある反復で展開済みの状態の g コストが下がったら, その反復では展開し直さずに INCONS リストに入れる
+  次の反復では open リストと INCONS リストを新しい w で並べ直し, プールとハッシュ表はそのまま使い回す
+  解の長さ / (open と INCONS の g + h の最小値) が最短経路の長さに対する倍率の上界になる (h が許容的なら)
+  g + h の最小値は, bidirectional_search と同じく f ごとの節点数を数えて差分で求める
+時間制限は TimeKeeper で与え, ハードリミットを超えたら反復の途中でも打ち切り, ソフトリミットを超えたら次の反復を始めない
+打ち切った反復で見つけた解も, そのときの上界とともに記録する
+
+節点の管理は a_star::Solver と同じく, プールとバケットキューとハッシュ表で行う
+w は WEIGHT_SCALE 倍した整数で扱い, 優先度 g * WEIGHT_SCALE + w * h をバケットキューの f とする
+状態に求めるものは a_star::Solver と同じ
+テンプレートを使用するためにヘッダに実装を書いている
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "a_star.hpp"
+#include "bucket_queue.hpp"
+#include "flat_hash_map.hpp"
+#include "time_keeper.hpp"
+
+namespace ara_star {
+
+using a_star::NodeIndex;
+using a_star::NO_PARENT;
+using a_star::StateHeuristic;
+
+// 重みの精度 (1 / WEIGHT_SCALE 刻み)
+static constexpr int WEIGHT_SCALE = 100;
+
+// 見つけた解の記録
+struct Solution {
+    int length;
+    double weight;
+    // 最短経路の長さに対する倍率の上界
+    double bound;
+    // 見つけた時点までの展開節点数の合計
+    int64_t expanded_count;
+    int64_t microseconds;
+};
+
+template <class State, class Heuristic = StateHeuristic>
+class Solver {
+public:
+    explicit Solver(Heuristic heuristic = Heuristic()) : heuristic_(heuristic) {}
+
+    // 重み付き A* 探索. ゴールまでの経路 (初期状態とゴールを含む) を返す. 解が無ければ空
+    std::vector<State> solve(const State& initial_state, const double weight);
+
+    // ARA*. 重みを initial_weight から weight_step ずつ 1 まで下げ, 時間内に見つけた最良の経路を返す
+    std::vector<State> solve(const State& initial_state, const TimeKeeper& time_keeper, const double initial_weight = 3.0, const double weight_step = 0.5);
+
+    // 直前の solve の反復ごとに見つけた解 (長さは短くなっていく)
+    const std::vector<Solution>& solutions() const;
+
+    // 直前の solve で最短経路であることが保証されたか
+    bool is_optimal() const;
+
+    int64_t expanded_count() const;
+
+    std::size_t node_count() const;
+
+    std::size_t size_in_bytes() const;
+
+private:
+    enum class Status : uint8_t { OPEN, INCONS, CLOSED };
+
+    struct Node {
+        State state;
+        NodeIndex parent;
+        // g + h (重みを掛けない)
+        int f_cost;
+        // 展開した, またはより小さい g の節点に置き換えられたら CLOSED
+        Status status;
+        // 展開した反復の番号
+        int closed_iteration;
+    };
+
+    Heuristic heuristic_;
+    std::vector<Node> nodes_;
+    BucketQueue<NodeIndex> frontier_;
+    // 状態のハッシュ値 -> 最良の節点の添字
+    FlatHashMap<NodeIndex> best_nodes_;
+    std::vector<NodeIndex> inconsistent_nodes_;
+    // open リストと INCONS リストの節点の f ごとの個数と, その最小値の候補
+    std::vector<int64_t> f_counts_;
+    int min_f_cost_ = 0;
+    NodeIndex goal_ = NO_PARENT;
+    int weight_ = WEIGHT_SCALE;
+    int iteration_ = 0;
+    int64_t expanded_count_ = 0;
+    std::vector<Solution> solutions_;
+    std::chrono::high_resolution_clock::time_point start_time_;
+
+    int priority(const Node& node) const;
+
+    void initialize(const State& initial_state);
+
+    void add_node(const State& state, const NodeIndex parent);
+
+    // open リスト (INCONS リスト) から外す
+    void close(const NodeIndex index);
+
+    // open リストと INCONS リストの g + h の最小値. 空なら INT_MAX
+    int get_min_f_cost();
+
+    // 新しい重みで open リストと INCONS リストを並べ直す
+    void reorder(const int weight);
+
+    // ゴールの g コストが open リストの優先度の最小値以下になるまで展開する. 時間切れなら false
+    bool improve_path(const TimeKeeper* time_keeper);
+
+    // 現在の解を記録する. 上界が 1 なら true
+    // is_completed が false (反復の途中で打ち切った) なら, 重みによる上界は使わない
+    bool record_solution(const bool is_completed);
+
+    std::vector<State> get_path() const;
+};
+
+template <class State, class Heuristic>
+inline int Solver<State, Heuristic>::priority(const Node& node) const {
+    return node.state.g_cost * WEIGHT_SCALE + weight_ * (node.f_cost - node.state.g_cost);
+}
+
+template <class State, class Heuristic>
+void Solver<State, Heuristic>::initialize(const State& initial_state) {
+    nodes_.clear();
+    frontier_.clear();
+    best_nodes_.clear();
+    inconsistent_nodes_.clear();
+    f_counts_.clear();
+    min_f_cost_ = 0;
+    solutions_.clear();
+    goal_ = NO_PARENT;
+    iteration_ = 0;
+    expanded_count_ = 0;
+    start_time_ = std::chrono::high_resolution_clock::now();
+    add_node(initial_state, NO_PARENT);
+}
+
+template <class State, class Heuristic>
+inline void Solver<State, Heuristic>::add_node(const State& state, const NodeIndex parent) {
+    Status status = Status::OPEN;
+    if (const auto* best = best_nodes_.find(state.hash_value); best != nullptr) {
+        const Node& node = nodes_[*best];
+        if (node.state.g_cost <= state.g_cost) {
+            return;
+        }
+        // この反復で展開済みなら, 次の反復まで展開しない
+        if (node.status == Status::CLOSED && node.closed_iteration == iteration_) {
+            status = Status::INCONS;
+        }
+        close(*best);
+    }
+    const int f_cost = state.g_cost + heuristic_(state);
+    const auto index = static_cast<NodeIndex>(nodes_.size());
+    nodes_.push_back({state, parent, f_cost, status, -1});
+    best_nodes_[state.hash_value] = index;
+    if (status == Status::OPEN) {
+        frontier_.push(priority(nodes_.back()), state.g_cost, index);
+    } else {
+        inconsistent_nodes_.emplace_back(index);
+    }
+    if (f_cost >= static_cast<int>(f_counts_.size())) {
+        f_counts_.resize(f_cost + 1, 0);
+    }
+    ++f_counts_[f_cost];
+    min_f_cost_ = std::min(min_f_cost_, f_cost);
+    if (state.is_done() && (goal_ == NO_PARENT || state.g_cost < nodes_[goal_].state.g_cost)) {
+        goal_ = index;
+    }
+}
+
+template <class State, class Heuristic>
+inline void Solver<State, Heuristic>::close(const NodeIndex index) {
+    Node& node = nodes_[index];
+    if (node.status != Status::CLOSED) {
+        node.status = Status::CLOSED;
+        --f_counts_[node.f_cost];
+    }
+}
+
+template <class State, class Heuristic>
+inline int Solver<State, Heuristic>::get_min_f_cost() {
+    while (min_f_cost_ < static_cast<int>(f_counts_.size()) && f_counts_[min_f_cost_] == 0) {
+        ++min_f_cost_;
+    }
+    return min_f_cost_ < static_cast<int>(f_counts_.size()) ? min_f_cost_ : INT_MAX;
+}
+
+template <class State, class Heuristic>
+void Solver<State, Heuristic>::reorder(const int weight) {
+    weight_ = weight;
+    std::vector<NodeIndex> open_nodes;
+    while (!frontier_.empty()) {
+        const NodeIndex index = frontier_.pop();
+        if (*best_nodes_.find(nodes_[index].state.hash_value) == index && nodes_[index].status == Status::OPEN) {
+            open_nodes.emplace_back(index);
+        }
+    }
+    for (const auto index : inconsistent_nodes_) {
+        if (*best_nodes_.find(nodes_[index].state.hash_value) == index) {
+            nodes_[index].status = Status::OPEN;
+            open_nodes.emplace_back(index);
+        }
+    }
+    inconsistent_nodes_.clear();
+    frontier_.clear();
+    for (const auto index : open_nodes) {
+        frontier_.push(priority(nodes_[index]), nodes_[index].state.g_cost, index);
+    }
+}
+
+template <class State, class Heuristic>
+bool Solver<State, Heuristic>::improve_path(const TimeKeeper* time_keeper) {
+    while (!frontier_.empty()) {
+        if (goal_ != NO_PARENT && nodes_[goal_].state.g_cost * WEIGHT_SCALE <= frontier_.min_f_cost()) {
+            return true;
+        }
+        const NodeIndex index = frontier_.pop();
+        // より小さい g で生成し直された状態の古い節点は飛ばす
+        if (*best_nodes_.find(nodes_[index].state.hash_value) != index || nodes_[index].status != Status::OPEN) {
+            continue;
+        }
+        if (time_keeper != nullptr && (expanded_count_ & 1023) == 0 && time_keeper->is_time_over()) {
+            frontier_.push(priority(nodes_[index]), nodes_[index].state.g_cost, index);
+            return false;
+        }
+        close(index);
+        nodes_[index].closed_iteration = iteration_;
+        ++expanded_count_;
+        // add_node でプールが再確保されると参照が無効になるので, 状態をコピーしておく
+        const State state = nodes_[index].state;
+        for (const auto action : state.legal_actions()) {
+            State next_state = state;
+            next_state.step(action);
+            add_node(next_state, index);
+        }
+    }
+    return true;
+}
+
+template <class State, class Heuristic>
+bool Solver<State, Heuristic>::record_solution(const bool is_completed) {
+    // open リストと INCONS リストの g + h の最小値は最短経路の長さの下界
+    const int lower_bound = get_min_f_cost();
+    const int length = nodes_[goal_].state.g_cost;
+    const double weight = static_cast<double>(weight_) / WEIGHT_SCALE;
+    // 調べ尽くしていれば最短経路
+    double bound = lower_bound >= length ? 1.0 : static_cast<double>(length) / std::max(1, lower_bound);
+    if (is_completed) {
+        bound = std::min(bound, weight);
+    }
+    const int64_t microseconds = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start_time_).count();
+    solutions_.push_back({length, weight, bound, expanded_count_, microseconds});
+    return bound <= 1.0;
+}
+
+template <class State, class Heuristic>
+std::vector<State> Solver<State, Heuristic>::solve(const State& initial_state, const double weight) {
+    weight_ = std::max(WEIGHT_SCALE, static_cast<int>(std::lround(weight * WEIGHT_SCALE)));
+    initialize(initial_state);
+    improve_path(nullptr);
+    if (goal_ == NO_PARENT) {
+        return {};
+    }
+    record_solution(true);
+    return get_path();
+}
+
+template <class State, class Heuristic>
+std::vector<State> Solver<State, Heuristic>::solve(const State& initial_state, const TimeKeeper& time_keeper, const double initial_weight, const double weight_step) {
+    weight_ = std::max(WEIGHT_SCALE, static_cast<int>(std::lround(initial_weight * WEIGHT_SCALE)));
+    const int step = std::max(1, static_cast<int>(std::lround(weight_step * WEIGHT_SCALE)));
+    initialize(initial_state);
+    while (true) {
+        if (!improve_path(&time_keeper)) {
+            // 打ち切った反復でより短い解が見つかっていれば, 返す経路と記録が食い違わないよう記録する
+            if (goal_ != NO_PARENT && (solutions_.empty() || nodes_[goal_].state.g_cost < solutions_.back().length)) {
+                record_solution(false);
+            }
+            break;
+        }
+        // 解の長さが変わらない反復でも, 上界は改善されるので記録する
+        if (goal_ != NO_PARENT && record_solution(true)) {
+            break;
+        }
+        // 解が無い
+        if (goal_ == NO_PARENT && frontier_.empty() && inconsistent_nodes_.empty()) {
+            break;
+        }
+        if (time_keeper.is_soft_time_over()) {
+            break;
+        }
+        ++iteration_;
+        reorder(std::max(WEIGHT_SCALE, weight_ - step));
+    }
+    return goal_ == NO_PARENT ? std::vector<State>() : get_path();
+}
+
+template <class State, class Heuristic>
+std::vector<State> Solver<State, Heuristic>::get_path() const {
+    std::vector<State> path;
+    for (NodeIndex index = goal_; index != NO_PARENT; index = nodes_[index].parent) {
+        path.emplace_back(nodes_[index].state);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+template <class State, class Heuristic>
+inline const std::vector<Solution>& Solver<State, Heuristic>::solutions() const {
+    return solutions_;
+}
+
+template <class State, class Heuristic>
+inline bool Solver<State, Heuristic>::is_optimal() const {
+    return !solutions_.empty() && solutions_.back().bound <= 1.0;
+}
+
+template <class State, class Heuristic>
+inline int64_t Solver<State, Heuristic>::expanded_count() const {
+    return expanded_count_;
+}
+
+template <class State, class Heuristic>
+inline std::size_t Solver<State, Heuristic>::node_count() const {
+    return nodes_.size();
+}
+
+template <class State, class Heuristic>
+inline std::size_t Solver<State, Heuristic>::size_in_bytes() const {
+    return nodes_.capacity() * sizeof(Node) + frontier_.size() * sizeof(NodeIndex) + best_nodes_.size_in_bytes()
+           + inconsistent_nodes_.capacity() * sizeof(NodeIndex);
+}
+
+} // namespace ara_star
@@ -0,0 +1,310 @@
+/*
+双方向ヒューリスティック探索 (MM)
+初期状態からの前向き探索と, ゴールからの後ろ向き探索を交互に進め, 両者が出会った状態で解を作る
+それぞれの向きは a_star::Solver と同じく, 節点プール, バケットキュー, ハッシュ表で管理する
+各向きの h コストはその向きの目的地 (前向きはゴール, 後ろ向きは初期状態) までの許容的な推定値
+MM の優先度 pr(n) = max(f(n), 2 g(n)) で open リストを並べるので, どちらの向きも経路の中点を超えて展開しない
+見つかった解の長さの最小値 U が, 次の 4 つの下界の最大値以下になったら, U が最短経路の長さである
+  C = 両方の open リストの pr の最小値の小さい方
+  前向きの open リストの f の最小値, 後ろ向きの open リストの f の最小値
+  前向きの g の最小値 + 後ろ向きの g の最小値 + 1 (辺のコストの最小値)
+f, g の最小値は open リストの節点の f, g ごとの個数から求める
+
+状態は a_star::Solver に求めるものに加えて, ハッシュ値が同じなら同じ状態で, 行動で前後に動ける (可逆) ことを前提とする
+テンプレートを使用するためにヘッダに実装を書いている
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "a_star.hpp"
+#include "bucket_queue.hpp"
+#include "flat_hash_map.hpp"
+
+namespace bidirectional_search {
+
+using a_star::NodeIndex;
+using a_star::NO_PARENT;
+using a_star::StateHeuristic;
+
+template <class State, class ForwardHeuristic = StateHeuristic, class BackwardHeuristic = StateHeuristic>
+class Solver {
+public:
+    Solver(ForwardHeuristic forward_heuristic, BackwardHeuristic backward_heuristic)
+        : forward_(forward_heuristic), backward_(backward_heuristic)
+    {}
+
+    // 初期状態からゴールまでの最短経路 (初期状態とゴールを含む) を返す. 解が無ければ空
+    std::vector<State> solve(const State& initial_state, const State& goal_state);
+
+    // 直前の solve で展開した節点数 (前向き, 後ろ向き, 合計)
+    int64_t forward_expanded_count() const;
+    int64_t backward_expanded_count() const;
+    int64_t expanded_count() const;
+
+    // 直前の solve で生成した節点数 (両方のプールの大きさの合計)
+    std::size_t node_count() const;
+
+    // 両方の向きのプール, キュー, ハッシュ表の使用メモリ (バイト)
+    std::size_t size_in_bytes() const;
+
+private:
+    struct Node {
+        State state;
+        NodeIndex parent;
+        int f_cost;
+        bool is_open;
+    };
+
+    // 1 つの向きの探索
+    template <class Heuristic>
+    struct Direction {
+        Heuristic heuristic;
+        std::vector<Node> nodes;
+        BucketQueue<NodeIndex> frontier;
+        // 状態のハッシュ値 -> 最良の節点の添字
+        FlatHashMap<NodeIndex> best_nodes;
+        // open リストの節点の f, g ごとの個数と, その最小値の候補
+        std::vector<int64_t> f_counts;
+        std::vector<int64_t> g_counts;
+        int min_f_cost = 0;
+        int min_g_cost = 0;
+        int64_t expanded_count = 0;
+
+        explicit Direction(Heuristic heuristic) : heuristic(heuristic) {}
+
+        void clear();
+
+        // 新しい節点なら追加して true
+        bool add_node(const State& state, const NodeIndex parent);
+
+        // open リストから外す
+        void close(const NodeIndex index);
+
+        // open リストの pr の最小値. 空なら INT_MAX
+        int min_priority();
+
+        // open リストが空でないときに呼ぶ
+        int get_min_f_cost();
+        int get_min_g_cost();
+
+        // state の g コスト. 無ければ -1
+        int find_g_cost(const State& state) const;
+
+        std::size_t size_in_bytes() const;
+    };
+
+    Direction<ForwardHeuristic> forward_;
+    Direction<BackwardHeuristic> backward_;
+    // 見つかった解の長さの最小値と, そのときに出会った状態
+    int best_cost_ = INT_MAX;
+    uint64_t meeting_hash_ = 0;
+
+    template <class From, class To>
+    void expand(From& from, const To& to);
+
+    std::vector<State> get_path() const;
+};
+
+template <class State, class ForwardHeuristic, class BackwardHeuristic>
+template <class Heuristic>
+void Solver<State, ForwardHeuristic, BackwardHeuristic>::Direction<Heuristic>::clear() {
+    nodes.clear();
+    frontier.clear();
+    best_nodes.clear();
+    f_counts.clear();
+    g_counts.clear();
+    min_f_cost = 0;
+    min_g_cost = 0;
+    expanded_count = 0;
+}
+
+template <class State, class ForwardHeuristic, class BackwardHeuristic>
+template <class Heuristic>
+inline bool Solver<State, ForwardHeuristic, BackwardHeuristic>::Direction<Heuristic>::add_node(const State& state, const NodeIndex parent) {
+    if (const auto* best = best_nodes.find(state.hash_value); best != nullptr) {
+        if (nodes[*best].state.g_cost <= state.g_cost) {
+            return false;
+        }
+        close(*best);
+    }
+    const int g_cost = state.g_cost;
+    const int f_cost = g_cost + heuristic(state);
+    const auto index = static_cast<NodeIndex>(nodes.size());
+    nodes.push_back({state, parent, f_cost, true});
+    best_nodes[state.hash_value] = index;
+    frontier.push(std::max(f_cost, 2 * g_cost), g_cost, index);
+    if (f_cost >= static_cast<int>(f_counts.size())) {
+        f_counts.resize(f_cost + 1, 0);
+    }
+    if (g_cost >= static_cast<int>(g_counts.size())) {
+        g_counts.resize(g_cost + 1, 0);
+    }
+    ++f_counts[f_cost];
+    ++g_counts[g_cost];
+    min_f_cost = std::min(min_f_cost, f_cost);
+    min_g_cost = std::min(min_g_cost, g_cost);
+    return true;
+}
+
+template <class State, class ForwardHeuristic, class BackwardHeuristic>
+template <class Heuristic>
+inline void Solver<State, ForwardHeuristic, BackwardHeuristic>::Direction<Heuristic>::close(const NodeIndex index) {
+    Node& node = nodes[index];
+    if (node.is_open) {
+        node.is_open = false;
+        --f_counts[node.f_cost];
+        --g_counts[node.state.g_cost];
+    }
+}
+
+template <class State, class ForwardHeuristic, class BackwardHeuristic>
+template <class Heuristic>
+inline int Solver<State, ForwardHeuristic, BackwardHeuristic>::Direction<Heuristic>::min_priority() {
+    // キューの先頭が古い節点なら捨てて, 本当の最小値を求める
+    while (!frontier.empty() && !nodes[frontier.top()].is_open) {
+        frontier.pop();
+    }
+    return frontier.empty() ? INT_MAX : frontier.min_f_cost();
+}
+
+template <class State, class ForwardHeuristic, class BackwardHeuristic>
+template <class Heuristic>
+inline int Solver<State, ForwardHeuristic, BackwardHeuristic>::Direction<Heuristic>::get_min_f_cost() {
+    while (f_counts[min_f_cost] == 0) {
+        ++min_f_cost;
+    }
+    return min_f_cost;
+}
+
+template <class State, class ForwardHeuristic, class BackwardHeuristic>
+template <class Heuristic>
+inline int Solver<State, ForwardHeuristic, BackwardHeuristic>::Direction<Heuristic>::get_min_g_cost() {
+    while (g_counts[min_g_cost] == 0) {
+        ++min_g_cost;
+    }
+    return min_g_cost;
+}
+
+template <class State, class ForwardHeuristic, class BackwardHeuristic>
+template <class Heuristic>
+inline int Solver<State, ForwardHeuristic, BackwardHeuristic>::Direction<Heuristic>::find_g_cost(const State& state) const {
+    const auto* best = best_nodes.find(state.hash_value);
+    return best == nullptr ? -1 : nodes[*best].state.g_cost;
+}
+
+template <class State, class ForwardHeuristic, class BackwardHeuristic>
+template <class Heuristic>
+inline std::size_t Solver<State, ForwardHeuristic, BackwardHeuristic>::Direction<Heuristic>::size_in_bytes() const {
+    return nodes.capacity() * sizeof(Node) + frontier.size() * sizeof(NodeIndex) + best_nodes.size_in_bytes();
+}
+
+template <class State, class ForwardHeuristic, class BackwardHeuristic>
+template <class From, class To>
+void Solver<State, ForwardHeuristic, BackwardHeuristic>::expand(From& from, const To& to) {
+    // min_priority で古い節点を捨てているので, 先頭は open な節点
+    const NodeIndex index = from.frontier.pop();
+    from.close(index);
+    ++from.expanded_count;
+    // add_node でプールが再確保されると参照が無効になるので, 状態をコピーしておく
+    const State state = from.nodes[index].state;
+    for (const auto action : state.legal_actions()) {
+        State next_state = state;
+        next_state.step(action);
+        if (!from.add_node(next_state, index)) {
+            continue;
+        }
+        // 反対向きの探索で生成済みなら解が 1 つ見つかった
+        if (const int g_cost = to.find_g_cost(next_state); g_cost >= 0 && next_state.g_cost + g_cost < best_cost_) {
+            best_cost_ = next_state.g_cost + g_cost;
+            meeting_hash_ = next_state.hash_value;
+        }
+    }
+}
+
+template <class State, class ForwardHeuristic, class BackwardHeuristic>
+std::vector<State> Solver<State, ForwardHeuristic, BackwardHeuristic>::solve(const State& initial_state, const State& goal_state) {
+    forward_.clear();
+    backward_.clear();
+    best_cost_ = INT_MAX;
+    forward_.add_node(initial_state, NO_PARENT);
+    backward_.add_node(goal_state, NO_PARENT);
+    if (initial_state.hash_value == goal_state.hash_value) {
+        best_cost_ = 0;
+        meeting_hash_ = initial_state.hash_value;
+    }
+    while (true) {
+        const int forward_priority = forward_.min_priority();
+        const int backward_priority = backward_.min_priority();
+        // どちらかの向きで調べ尽くした
+        if (forward_priority == INT_MAX || backward_priority == INT_MAX) {
+            break;
+        }
+        const int lower_bound = std::max({std::min(forward_priority, backward_priority), forward_.get_min_f_cost(), backward_.get_min_f_cost(),
+                                          forward_.get_min_g_cost() + backward_.get_min_g_cost() + 1});
+        if (best_cost_ <= lower_bound) {
+            break;
+        }
+        if (forward_priority <= backward_priority) {
+            expand(forward_, backward_);
+        } else {
+            expand(backward_, forward_);
+        }
+    }
+    return best_cost_ == INT_MAX ? std::vector<State>() : get_path();
+}
+
+template <class State, class ForwardHeuristic, class BackwardHeuristic>
+std::vector<State> Solver<State, ForwardHeuristic, BackwardHeuristic>::get_path() const {
+    // 初期状態から出会った状態まで
+    std::vector<State> path;
+    for (NodeIndex index = *forward_.best_nodes.find(meeting_hash_); index != NO_PARENT; index = forward_.nodes[index].parent) {
+        path.emplace_back(forward_.nodes[index].state);
+    }
+    std::reverse(path.begin(), path.end());
+    // 出会った状態からゴールまでは, 後ろ向きの節点の盤面に移る行動を探して前向きに進め, g コストなどを正しくする
+    const NodeIndex meeting_index = *backward_.best_nodes.find(meeting_hash_);
+    for (NodeIndex index = backward_.nodes[meeting_index].parent; index != NO_PARENT; index = backward_.nodes[index].parent) {
+        for (const auto action : path.back().legal_actions()) {
+            State next_state = path.back();
+            next_state.step(action);
+            if (next_state.hash_value == backward_.nodes[index].state.hash_value) {
+                path.emplace_back(next_state);
+                break;
+            }
+        }
+    }
+    return path;
+}
+
+template <class State, class ForwardHeuristic, class BackwardHeuristic>
+inline int64_t Solver<State, ForwardHeuristic, BackwardHeuristic>::forward_expanded_count() const {
+    return forward_.expanded_count;
+}
+
+template <class State, class ForwardHeuristic, class BackwardHeuristic>
+inline int64_t Solver<State, ForwardHeuristic, BackwardHeuristic>::backward_expanded_count() const {
+    return backward_.expanded_count;
+}
+
+template <class State, class ForwardHeuristic, class BackwardHeuristic>
+inline int64_t Solver<State, ForwardHeuristic, BackwardHeuristic>::expanded_count() const {
+    return forward_.expanded_count + backward_.expanded_count;
+}
+
+template <class State, class ForwardHeuristic, class BackwardHeuristic>
+inline std::size_t Solver<State, ForwardHeuristic, BackwardHeuristic>::node_count() const {
+    return forward_.nodes.size() + backward_.nodes.size();
+}
+
+template <class State, class ForwardHeuristic, class BackwardHeuristic>
+inline std::size_t Solver<State, ForwardHeuristic, BackwardHeuristic>::size_in_bytes() const {
+    return forward_.size_in_bytes() + backward_.size_in_bytes();
+}
+
+} // namespace bidirectional_search
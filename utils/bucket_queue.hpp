@@ -0,0 +1,114 @@
+/*
+バケット式の優先度付きキュー
+優先度 (f コスト) が小さな非負整数であることを利用して, f ごとに g ごとのバケットを持つ
+pop は f が最小のバケットのうち g が最大の値を返す (同じ f なら, ゴールに近いと期待できる深い節点を先に展開する)
+同じ (f, g) の中では後に入れたものから取り出す
+push, pop はどちらも償却定数時間 (g の走査は f 以下なので小さい)
+テンプレートを使用するためにヘッダに実装を書いている
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+template <class Value>
+class BucketQueue {
+public:
+    void push(const int f_cost, const int g_cost, const Value& value);
+
+    // 空でないときに呼ぶ
+    Value pop();
+
+    // 空でないときに呼ぶ. 次に pop される値
+    const Value& top();
+
+    bool empty() const;
+
+    std::size_t size() const;
+
+    // 空でないときに呼ぶ. 次に pop される値の f コスト
+    int min_f_cost();
+
+    void clear();
+
+private:
+    // buckets_[f][g]
+    std::vector<std::vector<std::vector<Value>>> buckets_;
+    // f ごとの要素数
+    std::vector<std::size_t> counts_;
+    // f ごとの, 要素がある可能性のある最大の g
+    std::vector<int> max_g_costs_;
+    int min_f_cost_ = 0;
+    std::size_t size_ = 0;
+};
+
+template <class Value>
+inline void BucketQueue<Value>::push(const int f_cost, const int g_cost, const Value& value) {
+    if (f_cost >= static_cast<int>(buckets_.size())) {
+        buckets_.resize(f_cost + 1);
+        counts_.resize(f_cost + 1, 0);
+        max_g_costs_.resize(f_cost + 1, 0);
+    }
+    auto& g_buckets = buckets_[f_cost];
+    if (g_cost >= static_cast<int>(g_buckets.size())) {
+        g_buckets.resize(g_cost + 1);
+    }
+    g_buckets[g_cost].emplace_back(value);
+    if (g_cost > max_g_costs_[f_cost]) {
+        max_g_costs_[f_cost] = g_cost;
+    }
+    if (size_ == 0 || f_cost < min_f_cost_) {
+        min_f_cost_ = f_cost;
+    }
+    ++counts_[f_cost];
+    ++size_;
+}
+
+template <class Value>
+inline int BucketQueue<Value>::min_f_cost() {
+    while (counts_[min_f_cost_] == 0) {
+        ++min_f_cost_;
+    }
+    return min_f_cost_;
+}
+
+template <class Value>
+inline const Value& BucketQueue<Value>::top() {
+    const int f_cost = min_f_cost();
+    auto& g_buckets = buckets_[f_cost];
+    int& g_cost = max_g_costs_[f_cost];
+    while (g_buckets[g_cost].empty()) {
+        --g_cost;
+    }
+    return g_buckets[g_cost].back();
+}
+
+template <class Value>
+inline Value BucketQueue<Value>::pop() {
+    Value value = top();
+    const int f_cost = min_f_cost_;
+    buckets_[f_cost][max_g_costs_[f_cost]].pop_back();
+    --counts_[f_cost];
+    --size_;
+    return value;
+}
+
+template <class Value>
+inline bool BucketQueue<Value>::empty() const {
+    return size_ == 0;
+}
+
+template <class Value>
+inline std::size_t BucketQueue<Value>::size() const {
+    return size_;
+}
+
+template <class Value>
+inline void BucketQueue<Value>::clear() {
+    buckets_.clear();
+    counts_.clear();
+    max_g_costs_.clear();
+    min_f_cost_ = 0;
+    size_ = 0;
+}
@@ -0,0 +1,119 @@
+/*
+持ち時間管理
+1 局全体の持ち時間 (と 1 手ごとの加算時間) から, 各手番の探索に使う時間を配分する
+配分は手数, 残り手数, 反復深化での最善手の変化と評価値の安定度から決め,
+探索側には TimeKeeper のハードリミットとソフトリミットとして渡す
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "time_keeper.hpp"
+
+class ClockManager {
+public:
+    // total_time, increment はミリ秒
+    explicit ClockManager(const int64_t total_time, const int64_t increment = 0)
+        : total_time_(total_time * 1000), increment_(increment * 1000)
+    {
+        start_game();
+    }
+
+    void start_game();
+
+    TimeKeeper start_move(const int remaining_moves);
+
+    void update_iteration(TimeKeeper& time_keeper, const bool is_best_action_changed, const double score_change);
+
+    void finish_move(const TimeKeeper& time_keeper);
+
+    int64_t remaining_time() const;
+
+    int time_over_count() const;
+
+private:
+    // 序盤は手が広く読みの価値が低いので, 配分を減らす手数
+    static constexpr int OPENING_MOVES = 4;
+    // 残り手数に加える余裕分
+    static constexpr int SAFETY_MOVES = 2;
+    // 評価値の変化量をこの値で割って不安定度とする
+    static constexpr double SCORE_SCALE = 4.0;
+
+    // 単位はマイクロ秒
+    int64_t total_time_;
+    int64_t increment_;
+    int64_t remaining_time_;
+
+    int move_number_;
+    int time_over_count_;
+
+    // 現在の手番の基本配分と, 反復ごとの最善手の変化回数・安定した反復の回数
+    int64_t base_soft_threshold_;
+    int best_action_change_count_;
+    int stable_iteration_count_;
+};
+
+inline void ClockManager::start_game() {
+    remaining_time_ = total_time_;
+    move_number_ = 0;
+    time_over_count_ = 0;
+}
+
+// remaining_moves: 自分が終局までに指す手数の見積もり
+inline TimeKeeper ClockManager::start_move(const int remaining_moves) {
+    const int64_t available_time = remaining_time_ + increment_;
+    const int moves_to_go = std::max(remaining_moves, 1) + SAFETY_MOVES;
+    int64_t soft_threshold = available_time / moves_to_go;
+    if (move_number_ < OPENING_MOVES) {
+        soft_threshold /= 2;
+    }
+    // ハードリミットはソフトリミットの 3 倍まで. ただし残り時間の 1/3 は超えない
+    const int64_t hard_threshold = std::max<int64_t>(std::min(soft_threshold * 3, available_time / 3), 0);
+
+    base_soft_threshold_ = soft_threshold;
+    best_action_change_count_ = 0;
+    stable_iteration_count_ = 0;
+    return TimeKeeper(std::chrono::microseconds(hard_threshold), std::chrono::microseconds(soft_threshold));
+}
+
+// 反復深化の 1 反復が終わるたびに呼び, ソフトリミットを伸縮させる
+// 最善手が変わったり評価値が大きく動いたりした局面では時間を多く使い, 安定していれば早めに打ち切る
+inline void ClockManager::update_iteration(TimeKeeper& time_keeper, const bool is_best_action_changed, const double score_change) {
+    const double instability = std::min(std::abs(score_change) / SCORE_SCALE, 1.0);
+    if (is_best_action_changed) {
+        ++best_action_change_count_;
+        stable_iteration_count_ = 0;
+    } else if (instability < 0.25) {
+        ++stable_iteration_count_;
+    } else {
+        stable_iteration_count_ = 0;
+    }
+    double factor = (1.0 + 0.4 * best_action_change_count_) * (1.0 + 0.5 * instability);
+    if (stable_iteration_count_ >= 3) {
+        factor *= 0.7;
+    }
+    time_keeper.set_soft_threshold(std::chrono::microseconds(static_cast<int64_t>(base_soft_threshold_ * factor)));
+}
+
+// 使った時間を持ち時間から引き, 加算時間を足す
+inline void ClockManager::finish_move(const TimeKeeper& time_keeper) {
+    remaining_time_ += increment_ - time_keeper.elapsed_microseconds();
+    if (remaining_time_ < 0) {
+        remaining_time_ = 0;
+        ++time_over_count_;
+    }
+    ++move_number_;
+}
+
+// 残りの持ち時間 (マイクロ秒)
+inline int64_t ClockManager::remaining_time() const {
+    return remaining_time_;
+}
+
+// 持ち時間を使い切った回数
+inline int ClockManager::time_over_count() const {
+    return time_over_count_;
+}
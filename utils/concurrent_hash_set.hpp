@@ -0,0 +1,109 @@
+/*
+ロックフリーなハッシュ値の集合
+固定サイズのオープンアドレス法 (線形探査) で, 空きスロットへの書き込みを compare_exchange で行う
+削除はできない. ハッシュ値 0 は空きを表すので, 0 のキーは別の値に置き換えて格納する
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+#include "zobrist_hashing.hpp"
+
+class ConcurrentHashSet {
+public:
+    using HashValue = zobrist_hashing::HashValue;
+
+    // size_mb: 表全体の大きさ (MB). スロット数は 2 のべき乗に切り下げる
+    explicit ConcurrentHashSet(const std::size_t size_mb);
+
+    // key を追加する. 新しく追加したら true, すでにあれば false
+    // 表が埋まっていて追加できなければ, 重複を許して true を返す
+    bool insert(HashValue key);
+
+    bool contains(HashValue key) const;
+
+    void clear();
+
+    std::size_t capacity() const;
+
+    // 追加できずに溢れたキーの数
+    std::size_t overflow_count() const;
+
+private:
+    // これ以上探査しても空きが見つからなければ溢れたとみなす
+    static constexpr std::size_t MAX_PROBE = 1024;
+
+    std::unique_ptr<std::atomic<HashValue>[]> slots_;
+    std::size_t mask_;
+    std::atomic<std::size_t> overflow_count_ = 0;
+
+    static HashValue normalize(const HashValue key);
+};
+
+inline ConcurrentHashSet::ConcurrentHashSet(const std::size_t size_mb) {
+    std::size_t slot_count = 1;
+    while (slot_count * 2 * sizeof(HashValue) <= size_mb * 1024 * 1024) {
+        slot_count *= 2;
+    }
+    slots_ = std::make_unique<std::atomic<HashValue>[]>(slot_count);
+    mask_ = slot_count - 1;
+    clear();
+}
+
+inline ConcurrentHashSet::HashValue ConcurrentHashSet::normalize(const HashValue key) {
+    return key ? key : 1;
+}
+
+inline bool ConcurrentHashSet::insert(HashValue key) {
+    key = normalize(key);
+    for (std::size_t probe = 0; probe < MAX_PROBE; ++probe) {
+        auto& slot = slots_[(key + probe) & mask_];
+        HashValue current = slot.load(std::memory_order_relaxed);
+        if (current == key) {
+            return false;
+        }
+        if (current == 0) {
+            if (slot.compare_exchange_strong(current, key, std::memory_order_relaxed)) {
+                return true;
+            }
+            // 他のスレッドが先に書き込んだ. 同じキーなら追加済み
+            if (current == key) {
+                return false;
+            }
+        }
+    }
+    overflow_count_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+inline bool ConcurrentHashSet::contains(HashValue key) const {
+    key = normalize(key);
+    for (std::size_t probe = 0; probe < MAX_PROBE; ++probe) {
+        const HashValue current = slots_[(key + probe) & mask_].load(std::memory_order_relaxed);
+        if (current == key) {
+            return true;
+        }
+        if (current == 0) {
+            return false;
+        }
+    }
+    return false;
+}
+
+inline void ConcurrentHashSet::clear() {
+    for (std::size_t index = 0; index <= mask_; ++index) {
+        slots_[index].store(0, std::memory_order_relaxed);
+    }
+    overflow_count_ = 0;
+}
+
+inline std::size_t ConcurrentHashSet::capacity() const {
+    return mask_ + 1;
+}
+
+inline std::size_t ConcurrentHashSet::overflow_count() const {
+    return overflow_count_.load();
+}
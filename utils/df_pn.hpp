@@ -0,0 +1,299 @@
+/*
+df-pn (depth-first proof-number search)
+手番側 (ルートの手番のプレイヤー) が勝ちを証明できるかを, 証明数・反証数の閾値付き深さ優先探索で求める
+証明数・反証数は TranspositionTable に保存し, 子の閾値には 1 + ε トリックを使う
+
+状態は generic_search::GameState (step, legal_actions, is_done, get_winning_status) を満たし, ハッシュ値を
+メンバ変数 hash_value またはメンバ関数 hash_value() で返せばよい
+step(action, undo_info) と undo を持つ状態は, 子を作るときに複製せず書き換えて戻す
+合法手が無いが終端でない局面 (オセロのパス) では, 値初期化した行動でパスする
+テンプレートを使用するためにヘッダに実装を書いている
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include "../games/play.hpp"
+#include "generic_search.hpp"
+#include "transposition_table.hpp"
+#include "zobrist_hashing.hpp"
+
+namespace df_pn {
+
+using HashValue = zobrist_hashing::HashValue;
+using ProofNumber = uint32_t;
+
+static constexpr ProofNumber INF = 100000000;
+
+enum class Result {
+    PROVEN, DISPROVEN, UNKNOWN
+};
+
+template <class State>
+HashValue get_hash_value(const State& state) {
+    if constexpr (requires { state.hash_value(); }) {
+        return state.hash_value();
+    } else {
+        return state.hash_value;
+    }
+}
+
+// 合法手の数. 状態が count_legal_actions() を持っていれば, 合法手を列挙せずに数える
+template <class State>
+std::size_t count_legal_actions(const State& state) {
+    if constexpr (requires { state.count_legal_actions(); }) {
+        return state.count_legal_actions();
+    } else {
+        return state.legal_actions().size();
+    }
+}
+
+// 証明数・反証数はルートの手番側から見た値
+// work は部分木で展開した節点数で, 置換時に多く展開したエントリを残す
+// is_path_dependent は, 探索経路上の局面への循環を含んで決まった値であることを表す
+struct Entry {
+    ProofNumber pn = 1;
+    ProofNumber dn = 1;
+    uint32_t depth : 31 = 0;
+    uint32_t is_path_dependent : 1 = false;
+};
+
+inline ProofNumber saturated_add(const ProofNumber a, const ProofNumber b) {
+    return std::min<uint64_t>(static_cast<uint64_t>(a) + b, INF);
+}
+
+template <class State>
+class Solver {
+public:
+    // is_draw_win: 引き分けも勝ちとみなすか (負けない ことの証明)
+    // epsilon: 1 + ε トリックの ε
+    explicit Solver(const std::size_t table_size_mb, const bool is_draw_win = false, const double epsilon = 0.25)
+        : table_(table_size_mb), is_draw_win_(is_draw_win), epsilon_(epsilon)
+    {}
+
+    // 表の値は局面だけで決まるので, 続けて別の局面を解くときも表を引き継ぐ
+    Result solve(const State& root);
+
+    void clear() {
+        table_.clear();
+    }
+
+    int64_t node_count() const {
+        return node_count_;
+    }
+
+private:
+    using Action = typename decltype(std::declval<State>().legal_actions())::value_type;
+
+    // OR 節点 (ルートの手番側が指す局面) と AND 節点で同じハッシュ値にならないようにする
+    static constexpr HashValue AND_NODE_KEY = 0x5D2A3F1C7B9E4860;
+
+    TranspositionTable<Entry, replacement::DepthPreferred> table_;
+    bool is_draw_win_;
+    double epsilon_;
+    int64_t node_count_ = 0;
+    std::vector<HashValue> path_;
+
+    HashValue get_key(const State& state, const bool is_or_node) const;
+    // 展開した節点の子. 局面は持たず, 子を探索するときに action で作り直す
+    // entry は子の証明数・反証数. is_fixed なら entry の値で確定している
+    struct Child {
+        Action action;
+        HashValue key;
+        bool is_fixed;
+        Entry entry;
+    };
+
+    // children_[深さ] : 探索中の経路上の節点の子. 節点に入るたびに確保し直さないよう使い回す
+    // deque なので, 深い節点の分を追加しても浅い節点の配列への参照は無効にならない
+    std::deque<std::vector<Child>> children_;
+
+    bool evaluate_terminal(const State& state, const bool is_or_node, Entry& entry) const;
+    bool initialize_child(const State& state, const bool is_or_node, const HashValue key, Entry& entry) const;
+    void look_up(Child& child) const;
+    Entry mid(State& state, const bool is_or_node, const ProofNumber pn_threshold, const ProofNumber dn_threshold);
+};
+
+template <class State>
+inline HashValue Solver<State>::get_key(const State& state, const bool is_or_node) const {
+    return get_hash_value(state) ^ (is_or_node ? 0 : AND_NODE_KEY);
+}
+
+// 終端局面なら証明数・反証数を entry に書き込んで true を返す
+template <class State>
+bool Solver<State>::evaluate_terminal(const State& state, const bool is_or_node, Entry& entry) const {
+    bool is_win = false;
+    switch (state.get_winning_status()) {
+    case WinningStatus::NONE:
+        return false;
+    case WinningStatus::WIN:
+        is_win = is_or_node;
+        break;
+    case WinningStatus::LOSE:
+        is_win = !is_or_node;
+        break;
+    default:
+        is_win = is_draw_win_;
+        break;
+    }
+    entry.pn = is_win ? 0 : INF;
+    entry.dn = is_win ? INF : 0;
+    return true;
+}
+
+// 子の証明数・反証数の初期値を求める. 経路上の局面 (循環) はルートの手番側の負けとみなす
+// 戻り値が true なら値が確定していて, 表を引く必要がない
+template <class State>
+bool Solver<State>::initialize_child(const State& state, const bool is_or_node, const HashValue key, Entry& entry) const {
+    entry = Entry();
+    if (std::find(path_.begin(), path_.end(), key) != path_.end()) {
+        entry.pn = INF;
+        entry.dn = 0;
+        entry.is_path_dependent = true;
+        return true;
+    }
+    if (evaluate_terminal(state, is_or_node, entry)) {
+        return true;
+    }
+    // 未探索の節点は合法手の数で初期化する (OR 節点はすべての手が反証されて初めて反証される)
+    const auto action_count = std::max<ProofNumber>(count_legal_actions(state), 1);
+    if (is_or_node) {
+        entry.dn = action_count;
+    } else {
+        entry.pn = action_count;
+    }
+    return false;
+}
+
+// 表に子の値があれば child.entry を置き換える
+template <class State>
+void Solver<State>::look_up(Child& child) const {
+    if (child.is_fixed) {
+        return;
+    }
+    if (const auto* stored = table_.find(child.key); stored != nullptr) {
+        // 別の経路で循環から決まった値は信用せず, 未探索として扱う
+        if (!stored->is_path_dependent || (stored->pn != 0 && stored->dn != 0)) {
+            child.entry = *stored;
+        }
+    }
+}
+
+// 証明数が pn_threshold 以上, または反証数が dn_threshold 以上になるまで state 以下を探索する
+// 子は state を step / undo で書き換えて作る (undo を持たない状態ではコピーする). 戻るときには state を元に戻している
+// 戻り値は state の証明数・反証数で, depth に展開した節点数を入れる
+template <class State>
+Entry Solver<State>::mid(State& state, const bool is_or_node, const ProofNumber pn_threshold, const ProofNumber dn_threshold) {
+    ++node_count_;
+    const auto key = get_key(state, is_or_node);
+    const std::size_t depth = path_.size();
+    path_.emplace_back(key);
+    if (children_.size() <= depth) {
+        children_.emplace_back();
+    }
+    auto& children = children_[depth];
+
+    // 子の値は入ったときに 1 度だけ求め, その後は探索した子の値だけを更新する
+    // 兄弟の値が別の経路から表で更新されていても, 古い値も正しい値なので証明・反証を誤ることはない
+    children.clear();
+    for (const auto action : state.legal_actions()) {
+        children.push_back({action, 0, false, Entry()});
+    }
+    if (children.empty()) {
+        children.push_back({Action{}, 0, false, Entry()});
+    }
+    for (auto& child : children) {
+        child.is_fixed = generic_search::search_child(state, child.action, [&](State& child_state) {
+            child.key = get_key(child_state, !is_or_node);
+            return initialize_child(child_state, !is_or_node, child.key, child.entry);
+        });
+    }
+    // 表を引くとキャッシュミスが多いので, 局面を作る処理と混ぜずにまとめて引く
+    for (auto& child : children) {
+        look_up(child);
+    }
+
+    int work = 1;
+    Entry entry;
+    while (true) {
+        // OR 節点: pn = 子の pn の最小値, dn = 子の dn の和
+        // AND 節点: pn = 子の pn の和, dn = 子の dn の最小値
+        ProofNumber min_number = INF;
+        ProofNumber second_number = INF;
+        ProofNumber sum_number = 0;
+        ProofNumber best_pn = INF;
+        ProofNumber best_dn = INF;
+        int best_idx = -1;
+        bool is_path_dependent = false;
+        for (int idx = 0; idx < static_cast<int>(children.size()); ++idx) {
+            const auto& child_entry = children[idx].entry;
+            is_path_dependent |= child_entry.is_path_dependent;
+            const ProofNumber number = is_or_node ? child_entry.pn : child_entry.dn;
+            sum_number = saturated_add(sum_number, is_or_node ? child_entry.dn : child_entry.pn);
+            if (number < min_number) {
+                second_number = min_number;
+                min_number = number;
+                best_idx = idx;
+                best_pn = child_entry.pn;
+                best_dn = child_entry.dn;
+            } else if (number < second_number) {
+                second_number = number;
+            }
+        }
+        entry.pn = is_or_node ? min_number : sum_number;
+        entry.dn = is_or_node ? sum_number : min_number;
+        entry.is_path_dependent = is_path_dependent;
+        if (entry.pn >= pn_threshold || entry.dn >= dn_threshold || best_idx < 0) {
+            break;
+        }
+
+        // 1 + ε トリック: 2 番目に良い子の値の (1 + ε) 倍まで, 最善の子を続けて探索する
+        const auto widened = static_cast<ProofNumber>(std::min<double>(std::ceil(second_number * (1.0 + epsilon_)), INF));
+        const ProofNumber second_threshold = std::max(widened, saturated_add(second_number, 1));
+        ProofNumber child_pn_threshold;
+        ProofNumber child_dn_threshold;
+        if (is_or_node) {
+            child_pn_threshold = std::min(pn_threshold, second_threshold);
+            child_dn_threshold = saturated_add(dn_threshold - std::min(dn_threshold, entry.dn), best_dn);
+        } else {
+            child_pn_threshold = saturated_add(pn_threshold - std::min(pn_threshold, entry.pn), best_pn);
+            child_dn_threshold = std::min(dn_threshold, second_threshold);
+        }
+        auto& best_child = children[best_idx];
+        best_child.entry = generic_search::search_child(state, best_child.action, [&](State& child_state) {
+            return mid(child_state, !is_or_node, child_pn_threshold, child_dn_threshold);
+        });
+        work += best_child.entry.depth;
+    }
+    path_.pop_back();
+
+    entry.depth = std::min(work, INT32_MAX);
+    table_.store(key, entry);
+    return entry;
+}
+
+template <class State>
+Result Solver<State>::solve(const State& root) {
+    node_count_ = 0;
+    path_.clear();
+    Entry entry;
+    if (!evaluate_terminal(root, true, entry)) {
+        State state = root;
+        entry = mid(state, true, INF, INF);
+    }
+    if (entry.pn == 0) {
+        return Result::PROVEN;
+    } else if (entry.dn == 0) {
+        return Result::DISPROVEN;
+    } else {
+        return Result::UNKNOWN;
+    }
+}
+
+} // namespace df_pn
@@ -0,0 +1,335 @@
+/*
+外部メモリを使うフロンティア幅優先探索
+状態は 64 ビット整数に詰めたもの (盤面のパック表現など) とし, 深さごとの層をディスク上のファイルに置く
+無向グラフ (すべての行動が可逆) を前提に, 深さ d + 1 の層 = 深さ d の層の後続 - 深さ d の層 - 深さ d - 1 の層 とし, 2 層前より古い層は消す
+
+重複の検出はハッシュ値による分割ファイルで遅延させて行う (hash-based delayed duplicate detection)
+  展開: 層の分割ファイルをスレッドで分担して大きなバッファで順に読み, 後続をハッシュ値で分割先に振り分ける
+        振り分け先ごとのバッファが一杯になったら, 整列して重複を除いてから, スレッドごとのファイルに追記する
+  統合: 分割先をスレッドで分担し, 1 つの分割先に書かれた後続をすべてメモリに読んで整列して重複を除き,
+        整列済みの直前 2 層の同じ分割ファイルと突き合わせて差を取り, 次の層の分割ファイルとして書き出す
+メモリに載るのは, 次の層の後続 (重複を含む) の 1 / partition_count 程度を thread_count 個と, 入出力のバッファだけ
+テンプレートを使用するためにヘッダに実装を書いている
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "thread_pool.hpp"
+
+namespace external_bfs {
+
+using Key = uint64_t;
+
+struct LayerStats {
+    int depth;
+    uint64_t count;
+    // 展開で書き出した後続の数 (バッファ内の重複を除いた後)
+    uint64_t generated_count;
+    // 統合で 1 度にメモリに載せた後続の最大数
+    uint64_t max_partition_size;
+    double seconds;
+};
+
+// 整列済みのファイルを先頭から順に読む. ファイルが無ければ空として扱う
+class RunReader {
+public:
+    RunReader(const std::string& path, const std::size_t buffer_size) : file_(std::fopen(path.c_str(), "rb")), buffer_(buffer_size) {}
+
+    ~RunReader() {
+        if (file_ != nullptr) {
+            std::fclose(file_);
+        }
+    }
+
+    RunReader(const RunReader&) = delete;
+    RunReader& operator=(const RunReader&) = delete;
+
+    // 次の値があれば key に入れて true
+    bool next(Key& key) {
+        if (position_ == size_) {
+            if (file_ == nullptr || (size_ = std::fread(buffer_.data(), sizeof(Key), buffer_.size(), file_)) == 0) {
+                return false;
+            }
+            position_ = 0;
+        }
+        key = buffer_[position_++];
+        return true;
+    }
+
+private:
+    std::FILE* file_;
+    std::vector<Key> buffer_;
+    std::size_t position_ = 0;
+    std::size_t size_ = 0;
+};
+
+// values をファイルの末尾に書き足す
+inline bool append_to_file(const std::string& path, const Key* values, const std::size_t size) {
+    std::FILE* file = std::fopen(path.c_str(), "ab");
+    if (file == nullptr) {
+        return false;
+    }
+    const bool is_written = std::fwrite(values, sizeof(Key), size, file) == size;
+    return std::fclose(file) == 0 && is_written;
+}
+
+// ファイルを消す. ファイルが無いときも true
+// プールのタスクの中からも呼ぶので, 例外を投げる版は使わない
+inline bool remove_file(const std::string& path) {
+    std::error_code error;
+    std::filesystem::remove(path, error);
+    return !error;
+}
+
+class Searcher {
+public:
+    // directory: 層と後続を置くディレクトリ
+    // buffer_size: 入出力のバッファの要素数 (分割先ごとの振り分けバッファも同じ大きさ)
+    Searcher(const std::string& directory, const int thread_count, const int partition_count = 64, const std::size_t buffer_size = 1 << 16)
+        : directory_(directory), thread_count_(std::max(1, thread_count)), partition_count_(std::max(1, partition_count)), buffer_size_(buffer_size)
+    {}
+
+    // root から深さ max_depth まで (すべて調べ尽くすまで) の層を数える
+    // expand(key, emit) は key の後続ごとに emit(後続) を呼ぶ. 複数のスレッドから同時に呼ばれる
+    // 入出力に失敗したら false
+    template <class Expand>
+    bool run(const Key root, Expand expand, const int max_depth = INT32_MAX);
+
+    // 深さごとの記録
+    const std::vector<LayerStats>& layers() const;
+
+    uint64_t total_count() const;
+
+private:
+    std::string directory_;
+    int thread_count_;
+    int partition_count_;
+    std::size_t buffer_size_;
+    std::vector<LayerStats> layers_;
+    std::atomic<bool> is_failed_ = false;
+
+    int partition(Key key) const;
+
+    std::string layer_path(const int depth, const int partition) const;
+
+    std::string successor_path(const int partition, const int thread) const;
+
+    // 整列して重複を除き, ファイルに追記して空にする
+    void flush(std::vector<Key>& buffer, const std::string& path, std::atomic<uint64_t>& generated_count);
+
+    // 深さ depth の層を展開して, 後続を分割先ごとのファイルに書く
+    template <class Expand>
+    void expand_layer(const int depth, Expand& expand, std::atomic<uint64_t>& generated_count);
+
+    // 分割先 partition の後続から深さ depth + 1 の層を作り, 状態数を返す
+    uint64_t merge_partition(const int depth, const int partition, std::atomic<uint64_t>& max_partition_size);
+};
+
+inline int Searcher::partition(Key key) const {
+    // MurmurHash3 の fmix64 でかき混ぜてから分割先を決める
+    key ^= key >> 33;
+    key *= 0xFF51AFD7ED558CCD;
+    key ^= key >> 33;
+    key *= 0xC4CEB9FE1A85EC53;
+    key ^= key >> 33;
+    return static_cast<int>(key % partition_count_);
+}
+
+inline std::string Searcher::layer_path(const int depth, const int partition) const {
+    return directory_ + "/layer_" + std::to_string(depth) + "_" + std::to_string(partition) + ".bin";
+}
+
+inline std::string Searcher::successor_path(const int partition, const int thread) const {
+    return directory_ + "/successors_" + std::to_string(partition) + "_" + std::to_string(thread) + ".bin";
+}
+
+inline void Searcher::flush(std::vector<Key>& buffer, const std::string& path, std::atomic<uint64_t>& generated_count) {
+    std::sort(buffer.begin(), buffer.end());
+    buffer.erase(std::unique(buffer.begin(), buffer.end()), buffer.end());
+    if (!append_to_file(path, buffer.data(), buffer.size())) {
+        is_failed_ = true;
+    }
+    generated_count += buffer.size();
+    buffer.clear();
+}
+
+template <class Expand>
+void Searcher::expand_layer(const int depth, Expand& expand, std::atomic<uint64_t>& generated_count) {
+    // outboxes[スレッド][分割先]
+    std::vector<std::vector<std::vector<Key>>> outboxes(thread_count_, std::vector<std::vector<Key>>(partition_count_));
+    {
+        WorkStealingPool pool(thread_count_);
+        for (int p = 0; p < partition_count_; ++p) {
+            pool.submit([this, depth, p, &expand, &outboxes, &generated_count] {
+                const int thread = WorkStealingPool::thread_index();
+                auto& thread_outboxes = outboxes[thread];
+                RunReader reader(layer_path(depth, p), buffer_size_);
+                for (Key key; reader.next(key); ) {
+                    expand(key, [&](const Key next_key) {
+                        const int q = partition(next_key);
+                        thread_outboxes[q].push_back(next_key);
+                        if (thread_outboxes[q].size() >= buffer_size_) {
+                            flush(thread_outboxes[q], successor_path(q, thread), generated_count);
+                        }
+                    });
+                }
+            });
+        }
+        pool.wait_idle();
+    }
+    for (int thread = 0; thread < thread_count_; ++thread) {
+        for (int q = 0; q < partition_count_; ++q) {
+            if (!outboxes[thread][q].empty()) {
+                flush(outboxes[thread][q], successor_path(q, thread), generated_count);
+            }
+        }
+    }
+}
+
+inline uint64_t Searcher::merge_partition(const int depth, const int p, std::atomic<uint64_t>& max_partition_size) {
+    std::vector<Key> successors;
+    for (int thread = 0; thread < thread_count_; ++thread) {
+        const std::string path = successor_path(p, thread);
+        RunReader reader(path, buffer_size_);
+        for (Key key; reader.next(key); ) {
+            successors.push_back(key);
+        }
+        if (!remove_file(path)) {
+            is_failed_ = true;
+        }
+    }
+    std::sort(successors.begin(), successors.end());
+    successors.erase(std::unique(successors.begin(), successors.end()), successors.end());
+    uint64_t size = max_partition_size.load();
+    while (successors.size() > size && !max_partition_size.compare_exchange_weak(size, successors.size())) {
+    }
+
+    // 直前 2 層に含まれるものを除く
+    RunReader current(layer_path(depth, p), buffer_size_);
+    RunReader previous(layer_path(depth - 1, p), buffer_size_);
+    Key current_key = 0;
+    Key previous_key = 0;
+    bool has_current = current.next(current_key);
+    bool has_previous = previous.next(previous_key);
+    const std::string output_path = layer_path(depth + 1, p);
+    std::vector<Key> output;
+    output.reserve(buffer_size_);
+    uint64_t count = 0;
+    if (!remove_file(output_path)) {
+        is_failed_ = true;
+    }
+    for (const Key key : successors) {
+        while (has_current && current_key < key) {
+            has_current = current.next(current_key);
+        }
+        while (has_previous && previous_key < key) {
+            has_previous = previous.next(previous_key);
+        }
+        if ((has_current && current_key == key) || (has_previous && previous_key == key)) {
+            continue;
+        }
+        output.push_back(key);
+        if (output.size() == buffer_size_) {
+            if (!append_to_file(output_path, output.data(), output.size())) {
+                is_failed_ = true;
+            }
+            count += output.size();
+            output.clear();
+        }
+    }
+    if (!output.empty()) {
+        if (!append_to_file(output_path, output.data(), output.size())) {
+            is_failed_ = true;
+        }
+        count += output.size();
+    }
+    return count;
+}
+
+template <class Expand>
+bool Searcher::run(const Key root, Expand expand, const int max_depth) {
+    layers_.clear();
+    is_failed_ = false;
+    std::error_code error;
+    std::filesystem::create_directories(directory_, error);
+    if (error) {
+        return false;
+    }
+    // 前回の実行の残りを消す
+    for (auto it = std::filesystem::directory_iterator(directory_, error); !error && it != std::filesystem::directory_iterator(); it.increment(error)) {
+        const std::string name = it->path().filename().string();
+        if ((name.rfind("layer_", 0) == 0 || name.rfind("successors_", 0) == 0) && !remove_file(it->path().string())) {
+            return false;
+        }
+    }
+    if (error) {
+        return false;
+    }
+    if (!append_to_file(layer_path(0, partition(root)), &root, 1)) {
+        return false;
+    }
+    layers_.push_back({0, 1, 0, 0, 0});
+
+    for (int depth = 0; depth < max_depth; ++depth) {
+        const auto start_time = std::chrono::high_resolution_clock::now();
+        std::atomic<uint64_t> generated_count = 0;
+        expand_layer(depth, expand, generated_count);
+
+        std::atomic<uint64_t> count = 0;
+        std::atomic<uint64_t> max_partition_size = 0;
+        {
+            WorkStealingPool pool(thread_count_);
+            for (int p = 0; p < partition_count_; ++p) {
+                pool.submit([this, depth, p, &count, &max_partition_size] {
+                    count += merge_partition(depth, p, max_partition_size);
+                    // 深さ depth - 1 の層はもう使わない
+                    if (!remove_file(layer_path(depth - 1, p))) {
+                        is_failed_ = true;
+                    }
+                });
+            }
+            pool.wait_idle();
+        }
+        if (is_failed_) {
+            return false;
+        }
+        if (count == 0) {
+            break;
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+        layers_.push_back({depth + 1, count, generated_count, max_partition_size, seconds});
+    }
+    // 残った層を消す
+    for (int p = 0; p < partition_count_; ++p) {
+        for (int depth = std::max(0, layers_.back().depth - 1); depth <= layers_.back().depth + 1; ++depth) {
+            if (!remove_file(layer_path(depth, p))) {
+                is_failed_ = true;
+            }
+        }
+    }
+    return !is_failed_;
+}
+
+inline const std::vector<LayerStats>& Searcher::layers() const {
+    return layers_;
+}
+
+inline uint64_t Searcher::total_count() const {
+    uint64_t count = 0;
+    for (const auto& layer : layers_) {
+        count += layer.count;
+    }
+    return count;
+}
+
+} // namespace external_bfs
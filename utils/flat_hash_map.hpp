@@ -0,0 +1,146 @@
+/*
+ハッシュ値をキーとする可変サイズのハッシュ表
+オープンアドレス法 (線形探査) で, キーと値を別々の配列に連続して持つ
+TranspositionTable と違ってエントリを上書きで失うことはなく, 使用率が半分を超えると 2 倍に拡張する
+削除はできない. キー 0 は空きを表すので, 0 のキーは 1 に置き換えて格納する
+キーはすでにかき混ぜられたハッシュ値であることを前提に, 下位ビットをそのまま添字に使う
+テンプレートを使用するためにヘッダに実装を書いている
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "zobrist_hashing.hpp"
+
+template <class Value>
+class FlatHashMap {
+public:
+    using HashValue = zobrist_hashing::HashValue;
+
+    // initial_capacity: 最初に確保するスロット数. 2 のべき乗に切り上げる
+    explicit FlatHashMap(const std::size_t initial_capacity = 1024);
+
+    Value* find(const HashValue key);
+    const Value* find(const HashValue key) const;
+
+    // key の値を返す. 無ければ値初期化して追加する
+    Value& operator[](const HashValue key);
+
+    std::size_t size() const;
+
+    std::size_t capacity() const;
+
+    std::size_t size_in_bytes() const;
+
+    void clear();
+
+private:
+    std::vector<HashValue> keys_;
+    std::vector<Value> values_;
+    std::size_t mask_;
+    std::size_t size_ = 0;
+
+    static HashValue normalize(const HashValue key);
+
+    // key のあるスロット, 無ければ key を入れるべき空きスロット
+    std::size_t find_slot(const HashValue key) const;
+
+    void grow();
+};
+
+template <class Value>
+inline FlatHashMap<Value>::FlatHashMap(const std::size_t initial_capacity) {
+    std::size_t slot_count = 1;
+    while (slot_count < initial_capacity) {
+        slot_count *= 2;
+    }
+    keys_.assign(slot_count, 0);
+    values_.resize(slot_count);
+    mask_ = slot_count - 1;
+}
+
+template <class Value>
+inline auto FlatHashMap<Value>::normalize(const HashValue key) -> HashValue {
+    return key ? key : 1;
+}
+
+template <class Value>
+inline std::size_t FlatHashMap<Value>::find_slot(const HashValue key) const {
+    std::size_t index = key & mask_;
+    while (keys_[index] != 0 && keys_[index] != key) {
+        index = (index + 1) & mask_;
+    }
+    return index;
+}
+
+template <class Value>
+inline Value* FlatHashMap<Value>::find(HashValue key) {
+    key = normalize(key);
+    const std::size_t index = find_slot(key);
+    return keys_[index] == key ? &values_[index] : nullptr;
+}
+
+template <class Value>
+inline const Value* FlatHashMap<Value>::find(HashValue key) const {
+    key = normalize(key);
+    const std::size_t index = find_slot(key);
+    return keys_[index] == key ? &values_[index] : nullptr;
+}
+
+template <class Value>
+inline Value& FlatHashMap<Value>::operator[](HashValue key) {
+    key = normalize(key);
+    std::size_t index = find_slot(key);
+    if (keys_[index] == key) {
+        return values_[index];
+    }
+    if ((size_ + 1) * 2 > keys_.size()) {
+        grow();
+        index = find_slot(key);
+    }
+    ++size_;
+    keys_[index] = key;
+    values_[index] = Value();
+    return values_[index];
+}
+
+template <class Value>
+inline void FlatHashMap<Value>::grow() {
+    auto old_keys = std::move(keys_);
+    auto old_values = std::move(values_);
+    keys_.assign(old_keys.size() * 2, 0);
+    values_ = std::vector<Value>(old_values.size() * 2);
+    mask_ = keys_.size() - 1;
+    for (std::size_t index = 0; index < old_keys.size(); ++index) {
+        if (old_keys[index] != 0) {
+            const std::size_t slot = find_slot(old_keys[index]);
+            keys_[slot] = old_keys[index];
+            values_[slot] = std::move(old_values[index]);
+        }
+    }
+}
+
+template <class Value>
+inline std::size_t FlatHashMap<Value>::size() const {
+    return size_;
+}
+
+template <class Value>
+inline std::size_t FlatHashMap<Value>::capacity() const {
+    return keys_.size();
+}
+
+template <class Value>
+inline std::size_t FlatHashMap<Value>::size_in_bytes() const {
+    return keys_.size() * (sizeof(HashValue) + sizeof(Value));
+}
+
+template <class Value>
+inline void FlatHashMap<Value>::clear() {
+    std::fill(keys_.begin(), keys_.end(), 0);
+    size_ = 0;
+}
@@ -0,0 +1,576 @@
+/*
+状態の要件を concept で表した汎用の探索
+  二人ゲーム        : アルファベータ探索, MCTS, AND/OR 木探索
+  一人ゲーム (パズル): A* (utils/a_star), IDA* (utils/ida_star) に要件を付けた別名
+状態, 評価関数, プレイアウトはテンプレート引数で受け取るので, std::function を介さずにインライン展開できる
+状態が step(action, undo_info) / undo(action, undo_info) を持てば, 子の節点ごとにコピーせず 1 つの状態を書き換えて探索する
+ゲームごとの実装 (02.alpha_beta, 07.mcts, 09.and_or, 10.transposition_table) と同じ順に節点を訪問する
+テンプレートを使用するためにヘッダに実装を書いている
+*/
+
+#pragma once
+
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../games/play.hpp"
+#include "a_star.hpp"
+#include "ida_star.hpp"
+#include "transposition_table.hpp"
+
+namespace generic_search {
+
+// 状態の行動の型 (legal_actions の要素の型)
+template <class State>
+using ActionOf = std::ranges::range_value_t<decltype(std::declval<const State&>().legal_actions())>;
+
+// 二人ゲームの状態. 勝敗は手番側から見たもの
+// 合法手が無いが終端でない局面では, 値初期化した行動 (オセロの NO_POS) でパスする
+template <class State>
+concept GameState = std::copyable<State> && requires(State state, const State& const_state, const ActionOf<State>& action) {
+    { const_state.legal_actions() } -> std::ranges::random_access_range;
+    { const_state.is_done() } -> std::convertible_to<bool>;
+    { const_state.get_winning_status() } -> std::same_as<WinningStatus>;
+    state.step(action);
+};
+
+// step(action, undo_info) の直後に undo(action, undo_info) を呼ぶと, その手を取り消せる状態
+template <class State>
+concept UndoableState = requires(State state, const ActionOf<State>& action, typename State::UndoInfo undo_info) {
+    state.step(action, undo_info);
+    state.undo(action, undo_info);
+};
+
+// ハッシュ値をメンバ関数 hash_value() かメンバ変数 hash_value で持つ状態
+template <class State>
+concept HashableState = requires(const State& state) {
+    { state.hash_value() } -> std::convertible_to<uint64_t>;
+} || requires(const State& state) {
+    { state.hash_value } -> std::convertible_to<uint64_t>;
+};
+
+// 局面の評価値 (手番側から見て大きいほど良い) を返す関数オブジェクト
+template <class Evaluator, class State>
+concept StateEvaluator = std::regular_invocable<const Evaluator&, const State&> && std::signed_integral<std::invoke_result_t<const Evaluator&, const State&>>;
+
+// 終端まで進めて, 開始時の手番側が勝てば 1, それ以外は 0 を返す関数オブジェクト
+template <class Playout, class State>
+concept StatePlayout = std::invocable<Playout&, State&> && std::convertible_to<std::invoke_result_t<Playout&, State&>, int>;
+
+template <HashableState State>
+inline uint64_t hash_of(const State& state) {
+    if constexpr (requires { state.hash_value(); }) {
+        return state.hash_value();
+    } else {
+        return state.hash_value;
+    }
+}
+
+// 状態のメンバ関数 get_score を評価値とする
+struct StateScore {
+    template <class State>
+    auto operator()(const State& state) const {
+        return state.get_score();
+    }
+};
+
+// 一様ランダムに選んだ合法手. 合法手が無ければパス
+template <GameState State, class Engine>
+inline ActionOf<State> random_action(const State& state, Engine& engine) {
+    const auto legal_actions = state.legal_actions();
+    if (std::ranges::empty(legal_actions)) {
+        return ActionOf<State>{};
+    }
+    return legal_actions[engine() % std::ranges::size(legal_actions)];
+}
+
+// 子の節点を探索する. 書き換えられる状態なら step / undo, そうでなければコピーした状態を search に渡す
+template <GameState State, class Search>
+inline auto search_child(State& state, const ActionOf<State>& action, Search&& search) {
+    if constexpr (UndoableState<State>) {
+        typename State::UndoInfo undo_info;
+        state.step(action, undo_info);
+        const auto result = search(state);
+        state.undo(action, undo_info);
+        return result;
+    } else {
+        State next_state = state;
+        next_state.step(action);
+        return search(next_state);
+    }
+}
+
+// 深さ制限付きのアルファベータ探索 (ネガマックス法)
+template <GameState State, class Evaluator = StateScore>
+    requires StateEvaluator<Evaluator, State>
+class AlphaBeta {
+public:
+    using Action = ActionOf<State>;
+    using Score = std::invoke_result_t<const Evaluator&, const State&>;
+
+    static constexpr Score INF = std::numeric_limits<Score>::max();
+
+    explicit AlphaBeta(Evaluator evaluator = Evaluator()) : evaluator_(evaluator) {}
+
+    // 手番側から見た評価値
+    Score score(State state, const Score alpha, const Score beta, const int depth);
+
+    // ルートの各子節点から depth 手先まで読んで, 最も評価値の高い行動を返す (02.alpha_beta と同じ深さ)
+    Action best_action(const State& state, const int depth);
+
+    // これまでに訪問した節点数
+    int64_t node_count() const;
+
+private:
+    Evaluator evaluator_;
+    int64_t node_count_ = 0;
+
+    Score search(State& state, Score alpha, const Score beta, const int depth);
+};
+
+template <GameState State, class Evaluator>
+    requires StateEvaluator<Evaluator, State>
+inline auto AlphaBeta<State, Evaluator>::score(State state, const Score alpha, const Score beta, const int depth) -> Score {
+    return search(state, alpha, beta, depth);
+}
+
+template <GameState State, class Evaluator>
+    requires StateEvaluator<Evaluator, State>
+auto AlphaBeta<State, Evaluator>::search(State& state, Score alpha, const Score beta, const int depth) -> Score {
+    ++node_count_;
+    if (state.is_done() || depth == 0) {
+        return evaluator_(state);
+    }
+    auto legal_actions = state.legal_actions();
+    if (legal_actions.empty()) {
+        legal_actions.emplace_back(Action{});
+    }
+    for (const auto action : legal_actions) {
+        const Score score = -search_child(state, action, [&](State& next_state) { return search(next_state, -beta, -alpha, depth - 1); });
+        if (score > alpha) {
+            alpha = score;
+        }
+        if (alpha >= beta) {
+            return alpha;
+        }
+    }
+    return alpha;
+}
+
+template <GameState State, class Evaluator>
+    requires StateEvaluator<Evaluator, State>
+auto AlphaBeta<State, Evaluator>::best_action(const State& state, const int depth) -> Action {
+    Action best_action{};
+    Score alpha = -INF;
+    const Score beta = INF;
+    State root_state = state;
+    for (const auto action : state.legal_actions()) {
+        const Score score = -search_child(root_state, action, [&](State& next_state) { return search(next_state, -beta, -alpha, depth); });
+        if (score > alpha) {
+            best_action = action;
+            alpha = score;
+        }
+    }
+    return best_action;
+}
+
+template <GameState State, class Evaluator>
+    requires StateEvaluator<Evaluator, State>
+inline int64_t AlphaBeta<State, Evaluator>::node_count() const {
+    return node_count_;
+}
+
+// 一様ランダムに手を選んで終端まで進めるプレイアウト
+// 乱数の種を指定すれば, 同じ種から同じプレイアウトを再現できる
+class RandomPlayout {
+public:
+    explicit RandomPlayout(const uint32_t seed = std::random_device()()) : engine_(seed) {}
+
+    template <GameState State>
+    int operator()(State& state);
+
+private:
+    std::mt19937 engine_;
+};
+
+// 07.mcts の再帰版と同じく, 終端で手番側が勝ちなら 1, それ以外は 0 とし, 1 手戻るごとに 1 - 値 にする
+template <GameState State>
+inline int RandomPlayout::operator()(State& state) {
+    int depth = 0;
+    while (!state.is_done()) {
+        state.step(random_action(state, engine_));
+        ++depth;
+    }
+    const int value = state.get_winning_status() == WinningStatus::WIN;
+    return depth & 1 ? 1 - value : value;
+}
+
+// UCB1 で子の節点を選び, 訪問回数が閾値に達した節点を展開するモンテカルロ木探索
+template <GameState State, class Playout = RandomPlayout>
+    requires StatePlayout<Playout, State>
+class Mcts {
+public:
+    using Action = ActionOf<State>;
+
+    explicit Mcts(Playout playout = Playout(), const int expand_threshold = 10, const double c = 1.) : playout_(std::move(playout)), expand_threshold_(expand_threshold), c_(c) {}
+
+    // playout_number 回プレイアウトして, ルートの子で訪問回数の最も多い行動を返す. 合法手が無ければパス
+    Action best_action(const State& state, const int playout_number);
+
+    // 以下は 1 つの木を手番をまたいで使うためのもの
+
+    // 木を捨てて, state をルートにする
+    void reset(const State& state);
+
+    // ルートの子に state と同じ局面 (ハッシュ値が同じ) があれば, その部分木を新しいルートにして true を返す
+    // 無ければ木を捨てて state をルートにし, false を返す
+    bool advance(const State& state)
+        requires HashableState<State>;
+
+    // is_stopped() が true を返すまでルートから探索を繰り返し, 繰り返した回数を返す
+    template <class StopCondition>
+    int64_t search(StopCondition&& is_stopped);
+
+    // ルートの子で訪問回数の最も多い行動. 合法手が無ければパス
+    Action best_action() const;
+
+    const State& root_state() const;
+
+    // ルートの訪問回数
+    int root_count() const;
+
+    // ルートの子の訪問回数 (ルートの legal_actions の順)
+    std::vector<int> child_counts() const;
+
+    // これまでに行ったプレイアウトの回数
+    int64_t playout_count() const;
+
+private:
+    struct Node {
+        State state;
+        std::vector<Node> child_nodes;
+        int count = 0;
+        int win = 0;
+    };
+
+    Playout playout_;
+    int expand_threshold_;
+    double c_;
+    int64_t playout_count_ = 0;
+    Node root_node_;
+
+    void expand(Node& node) const;
+
+    int evaluate(Node& node);
+
+    Node& next_child_node(Node& node) const;
+};
+
+template <GameState State, class Playout>
+    requires StatePlayout<Playout, State>
+void Mcts<State, Playout>::expand(Node& node) const {
+    node.child_nodes.clear();
+    for (const auto action : node.state.legal_actions()) {
+        node.child_nodes.push_back({node.state, {}, 0, 0});
+        node.child_nodes.back().state.step(action);
+    }
+}
+
+template <GameState State, class Playout>
+    requires StatePlayout<Playout, State>
+int Mcts<State, Playout>::evaluate(Node& node) {
+    int value = 0;
+    if (node.state.is_done()) {
+        value = node.state.get_winning_status() == WinningStatus::WIN;
+    } else if (node.child_nodes.empty()) {
+        State state = node.state;
+        value = playout_(state);
+        ++playout_count_;
+        if (node.count == expand_threshold_) {
+            expand(node);
+        }
+    } else {
+        value = 1 - evaluate(next_child_node(node));
+    }
+    node.win += value;
+    ++node.count;
+    return value;
+}
+
+template <GameState State, class Playout>
+    requires StatePlayout<Playout, State>
+auto Mcts<State, Playout>::next_child_node(Node& node) const -> Node& {
+    for (auto& child_node : node.child_nodes) {
+        if (child_node.count == 0) {
+            return child_node;
+        }
+    }
+    int t = 0;
+    for (const auto& child_node : node.child_nodes) {
+        t += child_node.count;
+    }
+    const double log_t = std::log(t);
+    double best_value = -std::numeric_limits<double>::infinity();
+    Node* best_child_node = nullptr;
+    for (auto& child_node : node.child_nodes) {
+        const double ucb1_value = 1 - static_cast<double>(child_node.win) / child_node.count + c_ * std::sqrt(log_t / child_node.count);
+        if (ucb1_value > best_value) {
+            best_child_node = &child_node;
+            best_value = ucb1_value;
+        }
+    }
+    return *best_child_node;
+}
+
+template <GameState State, class Playout>
+    requires StatePlayout<Playout, State>
+auto Mcts<State, Playout>::best_action(const State& state, const int playout_number) -> Action {
+    reset(state);
+    for (int t = 0; t < playout_number; ++t) {
+        evaluate(root_node_);
+    }
+    return best_action();
+}
+
+template <GameState State, class Playout>
+    requires StatePlayout<Playout, State>
+void Mcts<State, Playout>::reset(const State& state) {
+    root_node_ = {state, {}, 0, 0};
+    expand(root_node_);
+}
+
+template <GameState State, class Playout>
+    requires StatePlayout<Playout, State>
+bool Mcts<State, Playout>::advance(const State& state)
+    requires HashableState<State>
+{
+    const uint64_t hash_value = hash_of(state);
+    for (auto& child_node : root_node_.child_nodes) {
+        if (hash_of(child_node.state) == hash_value) {
+            // 子を取り出してから代入しないと, 代入で子の持ち主 (今のルート) が壊れる
+            Node node = std::move(child_node);
+            root_node_ = std::move(node);
+            if (root_node_.child_nodes.empty()) {
+                expand(root_node_);
+            }
+            return true;
+        }
+    }
+    reset(state);
+    return false;
+}
+
+template <GameState State, class Playout>
+    requires StatePlayout<Playout, State>
+template <class StopCondition>
+int64_t Mcts<State, Playout>::search(StopCondition&& is_stopped) {
+    int64_t count = 0;
+    for (; !is_stopped(); ++count) {
+        evaluate(root_node_);
+    }
+    return count;
+}
+
+template <GameState State, class Playout>
+    requires StatePlayout<Playout, State>
+auto Mcts<State, Playout>::best_action() const -> Action {
+    const auto legal_actions = root_node_.state.legal_actions();
+    if (std::ranges::empty(legal_actions)) {
+        return Action{};
+    }
+    std::size_t best_action_idx = 0;
+    for (std::size_t action_idx = 1; action_idx < root_node_.child_nodes.size(); ++action_idx) {
+        if (root_node_.child_nodes[action_idx].count > root_node_.child_nodes[best_action_idx].count) {
+            best_action_idx = action_idx;
+        }
+    }
+    return legal_actions[best_action_idx];
+}
+
+template <GameState State, class Playout>
+    requires StatePlayout<Playout, State>
+inline const State& Mcts<State, Playout>::root_state() const {
+    return root_node_.state;
+}
+
+template <GameState State, class Playout>
+    requires StatePlayout<Playout, State>
+inline int Mcts<State, Playout>::root_count() const {
+    return root_node_.count;
+}
+
+template <GameState State, class Playout>
+    requires StatePlayout<Playout, State>
+std::vector<int> Mcts<State, Playout>::child_counts() const {
+    std::vector<int> counts;
+    for (const auto& child_node : root_node_.child_nodes) {
+        counts.emplace_back(child_node.count);
+    }
+    return counts;
+}
+
+template <GameState State, class Playout>
+    requires StatePlayout<Playout, State>
+inline int64_t Mcts<State, Playout>::playout_count() const {
+    return playout_count_;
+}
+
+// 手番側が必ず勝てるかを調べる AND/OR 木探索
+// USE_TABLE なら, 調べた節点の値をトランスポジションテーブルに記録して再利用する (10.transposition_table)
+template <GameState State, bool USE_TABLE = false>
+    requires (!USE_TABLE || HashableState<State>)
+class AndOr {
+public:
+    using Action = ActionOf<State>;
+
+    // table_size_mb: USE_TABLE のときのトランスポジションテーブルの大きさ
+    explicit AndOr(const std::size_t table_size_mb = 1) : table_(USE_TABLE ? table_size_mb : 0) {}
+
+    // 必ず勝てる行動があればそれを, 無ければ最初の合法手を返す
+    Action best_action(const State& state);
+
+    // これまでに訪問した節点数
+    int64_t node_count() const;
+
+private:
+    // AND 節点と OR 節点で同じ局面を区別するためにハッシュ値に混ぜる値
+    static constexpr uint64_t AND_NODE_KEY = 0x616E645F6E6F6465;
+
+    struct NoTable {
+        explicit NoTable(const std::size_t) {}
+    };
+
+    std::conditional_t<USE_TABLE, TranspositionTable<int>, NoTable> table_;
+    int64_t node_count_ = 0;
+
+    // 手番側から見て, 相手 (ルートの手番側) が必ず勝てるなら 1
+    int and_score(State& state);
+
+    // 手番側が必ず勝てるなら 1
+    int or_score(State& state);
+
+    template <bool IS_AND>
+    int child_score(State& state);
+};
+
+template <GameState State, bool USE_TABLE>
+    requires (!USE_TABLE || HashableState<State>)
+template <bool IS_AND>
+inline int AndOr<State, USE_TABLE>::child_score(State& state) {
+    if constexpr (USE_TABLE) {
+        const uint64_t key = hash_of(state) ^ (IS_AND ? AND_NODE_KEY : 0);
+        if (const auto* value = table_.find(key); value != nullptr) {
+            return *value;
+        }
+        const int value = IS_AND ? and_score(state) : or_score(state);
+        table_.store(key, value);
+        return value;
+    } else {
+        return IS_AND ? and_score(state) : or_score(state);
+    }
+}
+
+template <GameState State, bool USE_TABLE>
+    requires (!USE_TABLE || HashableState<State>)
+int AndOr<State, USE_TABLE>::and_score(State& state) {
+    ++node_count_;
+    switch (state.get_winning_status()) {
+    case WinningStatus::LOSE:
+        return 1;
+    case WinningStatus::WIN:
+    case WinningStatus::DRAW:
+        return 0;
+    default:
+        for (const auto action : state.legal_actions()) {
+            if (!search_child(state, action, [&](State& next_state) { return child_score<false>(next_state); })) {
+                return 0;
+            }
+        }
+        return 1;
+    }
+}
+
+template <GameState State, bool USE_TABLE>
+    requires (!USE_TABLE || HashableState<State>)
+int AndOr<State, USE_TABLE>::or_score(State& state) {
+    ++node_count_;
+    switch (state.get_winning_status()) {
+    case WinningStatus::WIN:
+        return 1;
+    case WinningStatus::LOSE:
+    case WinningStatus::DRAW:
+        return 0;
+    default:
+        for (const auto action : state.legal_actions()) {
+            if (search_child(state, action, [&](State& next_state) { return child_score<true>(next_state); })) {
+                return 1;
+            }
+        }
+        return 0;
+    }
+}
+
+template <GameState State, bool USE_TABLE>
+    requires (!USE_TABLE || HashableState<State>)
+auto AndOr<State, USE_TABLE>::best_action(const State& state) -> Action {
+    if constexpr (USE_TABLE) {
+        table_.clear();
+    }
+    const auto legal_actions = state.legal_actions();
+    State root_state = state;
+    for (const auto action : legal_actions) {
+        if (search_child(root_state, action, [&](State& next_state) { return child_score<true>(next_state); })) {
+            return action;
+        }
+    }
+    return legal_actions[0];
+}
+
+template <GameState State, bool USE_TABLE>
+    requires (!USE_TABLE || HashableState<State>)
+inline int64_t AndOr<State, USE_TABLE>::node_count() const {
+    return node_count_;
+}
+
+// 一人ゲーム (パズル) の状態. utils/a_star の要件
+template <class State>
+concept PuzzleState = std::copyable<State> && requires(State state, const State& const_state, const ActionOf<State>& action) {
+    { const_state.is_done() } -> std::convertible_to<bool>;
+    state.step(action);
+    { const_state.g_cost } -> std::convertible_to<int>;
+    { const_state.hash_value } -> std::convertible_to<uint64_t>;
+};
+
+// 1 つの状態を書き換えて探索できるパズルの状態. utils/ida_star の要件
+template <class State>
+concept InPlacePuzzleState = requires(State state, const State& const_state, const int action, typename State::UndoInfo undo_info) {
+    { State::ACTION_COUNT } -> std::convertible_to<int>;
+    { State::inverse_action(action) } -> std::convertible_to<int>;
+    { const_state.is_legal_action(action) } -> std::convertible_to<bool>;
+    { const_state.is_done() } -> std::convertible_to<bool>;
+    { const_state.g_cost } -> std::convertible_to<int>;
+    state.step(action, undo_info);
+    state.undo(action, undo_info);
+};
+
+// 状態の h コストを返す関数オブジェクト
+template <class Heuristic, class State>
+concept PuzzleHeuristic = std::regular_invocable<const Heuristic&, const State&> && std::convertible_to<std::invoke_result_t<const Heuristic&, const State&>, int>;
+
+template <PuzzleState State, class Heuristic = a_star::StateHeuristic>
+    requires PuzzleHeuristic<Heuristic, State>
+using AStar = a_star::Solver<State, Heuristic>;
+
+template <InPlacePuzzleState State, class Heuristic = ida_star::StateHeuristic>
+    requires PuzzleHeuristic<Heuristic, State>
+using IdaStar = ida_star::Solver<State, Heuristic>;
+
+} // namespace generic_search
@@ -0,0 +1,284 @@
+/*
+HDA* (Hash Distributed A*)
+状態のハッシュ値でその状態を担当するスレッド (所有者) を決め, 各スレッドは自分の担当する状態だけの
+節点プール, open リスト (バケットキュー), closed リスト (ハッシュ表) を持つ (a_star::Solver と同じ構造)
+展開して生成した子は所有者ごとにまとめ, 一定数たまるか手が空いたときに所有者のロックフリーなキューへ送る
+
+解のコストの上界 (見つかったゴールの g コストの最小値) を共有し, f コストが上界以上の節点は展開しない
+終了判定は 1 つの atomic なカウンタで行う
+  カウンタ = 処理待ちの節点を持つスレッドの数 + 送られてまだ処理されていないまとまりの数
+  スレッドは, 受け取ったまとまりを処理する前にカウンタを増やしてから作業中に戻るので, 送信中の節点がある間は 0 にならない
+  0 になったら, どのスレッドにも上界より小さい f コストの節点が無く, 送信中の節点も無いので, 上界が最短経路の長さである
+
+状態に求めるものは a_star::Solver と同じ
+テンプレートを使用するためにヘッダに実装を書いている
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "a_star.hpp"
+#include "bucket_queue.hpp"
+#include "flat_hash_map.hpp"
+#include "mpsc_queue.hpp"
+
+namespace hda_star {
+
+using a_star::NodeIndex;
+using a_star::StateHeuristic;
+
+// 他のスレッドの節点プールの節点を指す
+struct NodeRef {
+    int32_t thread;
+    NodeIndex index;
+};
+
+static constexpr NodeRef NO_PARENT = {-1, 0};
+
+template <class State, class Heuristic = StateHeuristic>
+class Solver {
+public:
+    // batch_size: 他のスレッドへ送る節点をまとめる数
+    explicit Solver(const int thread_count, const std::size_t batch_size = 64, Heuristic heuristic = Heuristic())
+        : thread_count_(std::max(1, thread_count)), batch_size_(batch_size), heuristic_(heuristic)
+    {}
+
+    // 初期状態からゴールまでの最短経路 (初期状態とゴールを含む) を返す. 解が無ければ空
+    std::vector<State> solve(const State& initial_state);
+
+    // 直前の solve で展開した節点数
+    int64_t expanded_count() const;
+
+    // 直前の solve でのスレッドごとの展開節点数
+    std::vector<int64_t> thread_expanded_counts() const;
+
+    // 直前の solve で他のスレッドへ送った節点数
+    int64_t sent_count() const;
+
+private:
+    struct Node {
+        State state;
+        NodeRef parent;
+    };
+
+    struct Message {
+        State state;
+        NodeRef parent;
+    };
+
+    struct Worker {
+        std::vector<Node> nodes;
+        BucketQueue<NodeIndex> frontier;
+        FlatHashMap<NodeIndex> best_nodes;
+        MPSCQueue<std::vector<Message>> inbox;
+        // 送り先のスレッドごとにためている節点
+        std::vector<std::vector<Message>> outboxes;
+        int64_t expanded_count = 0;
+        int64_t sent_count = 0;
+    };
+
+    // 展開した節点数ごとに, ためている節点を送る
+    static constexpr int64_t FLUSH_INTERVAL = 64;
+
+    int thread_count_;
+    std::size_t batch_size_;
+    Heuristic heuristic_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<int64_t> active_count_ = 0;
+    // 見つかったゴールの g コストの最小値と, その節点
+    std::atomic<int> upper_bound_ = INT_MAX;
+    std::mutex goal_mutex_;
+    NodeRef goal_ = NO_PARENT;
+
+    int owner(const State& state) const;
+
+    void add_node(Worker& worker, const State& state, const NodeRef parent);
+
+    void send(Worker& worker, const int destination);
+
+    void flush(Worker& worker);
+
+    // 受け取ったまとまりを処理し, 処理したまとまりの数を返す
+    int receive(Worker& worker);
+
+    void run(const int thread);
+};
+
+template <class State, class Heuristic>
+inline int Solver<State, Heuristic>::owner(const State& state) const {
+    // 下位ビットはハッシュ表の添字に使うので, 上位ビットで振り分ける
+    return (state.hash_value >> 32) % thread_count_;
+}
+
+template <class State, class Heuristic>
+inline void Solver<State, Heuristic>::add_node(Worker& worker, const State& state, const NodeRef parent) {
+    if (const auto* best = worker.best_nodes.find(state.hash_value); best != nullptr && worker.nodes[*best].state.g_cost <= state.g_cost) {
+        return;
+    }
+    const auto index = static_cast<NodeIndex>(worker.nodes.size());
+    worker.nodes.push_back({state, parent});
+    worker.best_nodes[state.hash_value] = index;
+    worker.frontier.push(state.g_cost + heuristic_(state), state.g_cost, index);
+}
+
+template <class State, class Heuristic>
+inline void Solver<State, Heuristic>::send(Worker& worker, const int destination) {
+    auto& outbox = worker.outboxes[destination];
+    worker.sent_count += outbox.size();
+    // 受け取られるまでカウンタに含める
+    active_count_.fetch_add(1);
+    workers_[destination]->inbox.push(std::move(outbox));
+    outbox = std::vector<Message>();
+    outbox.reserve(batch_size_);
+}
+
+template <class State, class Heuristic>
+void Solver<State, Heuristic>::flush(Worker& worker) {
+    for (int destination = 0; destination < thread_count_; ++destination) {
+        if (!worker.outboxes[destination].empty()) {
+            send(worker, destination);
+        }
+    }
+}
+
+template <class State, class Heuristic>
+int Solver<State, Heuristic>::receive(Worker& worker) {
+    return worker.inbox.consume_all([this, &worker](std::vector<Message>&& messages) {
+        for (const auto& message : messages) {
+            add_node(worker, message.state, message.parent);
+        }
+    });
+}
+
+template <class State, class Heuristic>
+void Solver<State, Heuristic>::run(const int thread) {
+    Worker& worker = *workers_[thread];
+    int64_t expanded_since_flush = 0;
+    while (true) {
+        if (const int count = receive(worker); count > 0) {
+            active_count_.fetch_sub(count);
+        }
+        // 上界より f コストが小さい節点があれば展開する
+        bool has_work = false;
+        while (!worker.frontier.empty()) {
+            if (worker.frontier.min_f_cost() >= upper_bound_.load(std::memory_order_relaxed)) {
+                break;
+            }
+            const NodeIndex index = worker.frontier.pop();
+            if (*worker.best_nodes.find(worker.nodes[index].state.hash_value) != index) {
+                continue;
+            }
+            has_work = true;
+            const State state = worker.nodes[index].state;
+            if (state.is_done()) {
+                std::lock_guard lock(goal_mutex_);
+                if (state.g_cost < upper_bound_.load()) {
+                    upper_bound_ = state.g_cost;
+                    goal_ = {thread, index};
+                }
+                break;
+            }
+            ++worker.expanded_count;
+            for (const auto action : state.legal_actions()) {
+                State next_state = state;
+                next_state.step(action);
+                const int destination = owner(next_state);
+                if (destination == thread) {
+                    add_node(worker, next_state, {thread, index});
+                } else {
+                    worker.outboxes[destination].push_back({next_state, {thread, index}});
+                    if (worker.outboxes[destination].size() >= batch_size_) {
+                        send(worker, destination);
+                    }
+                }
+            }
+            break;
+        }
+        if (has_work) {
+            if (++expanded_since_flush >= FLUSH_INTERVAL) {
+                flush(worker);
+                expanded_since_flush = 0;
+            }
+            continue;
+        }
+        // 処理待ちの節点が無くなった. ためている節点を送ってから待機する
+        flush(worker);
+        expanded_since_flush = 0;
+        active_count_.fetch_sub(1);
+        while (true) {
+            if (!worker.inbox.empty()) {
+                // まとまりの分がカウンタに含まれているので, ここで 0 になることはない
+                active_count_.fetch_add(1);
+                break;
+            }
+            if (active_count_.load() == 0) {
+                return;
+            }
+            std::this_thread::yield();
+        }
+    }
+}
+
+template <class State, class Heuristic>
+std::vector<State> Solver<State, Heuristic>::solve(const State& initial_state) {
+    workers_.clear();
+    for (int thread = 0; thread < thread_count_; ++thread) {
+        workers_.emplace_back(std::make_unique<Worker>());
+        workers_.back()->outboxes.resize(thread_count_);
+    }
+    upper_bound_ = INT_MAX;
+    goal_ = NO_PARENT;
+    active_count_ = thread_count_;
+    add_node(*workers_[owner(initial_state)], initial_state, NO_PARENT);
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < thread_count_; ++thread) {
+        threads.emplace_back([this, thread] { run(thread); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    // すべてのスレッドが止まっているので, 他のスレッドの節点プールを辿ってよい
+    std::vector<State> shortest_path;
+    for (NodeRef ref = goal_; ref.thread >= 0; ref = workers_[ref.thread]->nodes[ref.index].parent) {
+        shortest_path.emplace_back(workers_[ref.thread]->nodes[ref.index].state);
+    }
+    std::reverse(shortest_path.begin(), shortest_path.end());
+    return shortest_path;
+}
+
+template <class State, class Heuristic>
+inline int64_t Solver<State, Heuristic>::expanded_count() const {
+    int64_t count = 0;
+    for (const auto& worker : workers_) {
+        count += worker->expanded_count;
+    }
+    return count;
+}
+
+template <class State, class Heuristic>
+inline std::vector<int64_t> Solver<State, Heuristic>::thread_expanded_counts() const {
+    std::vector<int64_t> counts;
+    for (const auto& worker : workers_) {
+        counts.emplace_back(worker->expanded_count);
+    }
+    return counts;
+}
+
+template <class State, class Heuristic>
+inline int64_t Solver<State, Heuristic>::sent_count() const {
+    int64_t count = 0;
+    for (const auto& worker : workers_) {
+        count += worker->sent_count;
+    }
+    return count;
+}
+
+} // namespace hda_star
@@ -0,0 +1,138 @@
+/*
+反復深化 A* 探索
+1 つの状態を step / undo で書き換えながら, f コストが閾値以下の節点だけを深さ優先で探索する
+閾値は初期状態の h コストから始め, 閾値を超えた f コストの最小値に更新していく
+直前の手を取り消す手は生成しないので, 親に戻る枝は探索しない
+使用メモリは探索深さに比例する (現在の経路の行動列のみ)
+
+状態は step(action, undo_info), undo(action, undo_info), is_done, is_legal_action, メンバ変数 g_cost と,
+undo に使う情報の型 UndoInfo, 行動数 ACTION_COUNT (行動は 0 ~ ACTION_COUNT - 1), 逆向きの行動を返す静的メンバ関数 inverse_action を持てばよい
+h コストは Heuristic で計算する (既定では状態のメンバ変数 h_cost)
+テンプレートを使用するためにヘッダに実装を書いている
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+namespace ida_star {
+
+// 状態が持つ h コストをそのまま使う
+struct StateHeuristic {
+    template <class State>
+    int operator()(const State& state) const {
+        return state.h_cost;
+    }
+};
+
+// 1 回の閾値での探索の記録
+struct IterationStats {
+    int threshold;
+    int64_t node_count;
+    double seconds;
+};
+
+template <class State, class Heuristic = StateHeuristic>
+class Solver {
+public:
+    explicit Solver(Heuristic heuristic = Heuristic()) : heuristic_(heuristic) {}
+
+    // 初期状態からゴールまでの行動列を返す
+    // 閾値が max_threshold を超えたら諦めて空の行動列を返す
+    std::vector<int> solve(State state, const int max_threshold = INT_MAX);
+
+    // 直前の solve で最短経路が見つかったか
+    bool is_solved() const;
+
+    // 直前の solve の閾値ごとの記録
+    const std::vector<IterationStats>& iterations() const;
+
+    int64_t total_node_count() const;
+
+private:
+    static constexpr int NO_ACTION = -1;
+
+    Heuristic heuristic_;
+    int threshold_ = 0;
+    // 閾値を超えた f コストの最小値
+    int next_threshold_ = INT_MAX;
+    int64_t node_count_ = 0;
+    bool is_solved_ = false;
+    std::vector<IterationStats> iterations_;
+    // ルートから現在の節点までの行動列
+    std::vector<int> path_;
+
+    bool search(State& state, const int pre_action);
+};
+
+template <class State, class Heuristic>
+std::vector<int> Solver<State, Heuristic>::solve(State state, const int max_threshold) {
+    path_.clear();
+    iterations_.clear();
+    is_solved_ = false;
+    for (int threshold = state.g_cost + heuristic_(state); threshold <= max_threshold; threshold = next_threshold_) {
+        threshold_ = threshold;
+        next_threshold_ = INT_MAX;
+        node_count_ = 0;
+        const auto start_time = std::chrono::high_resolution_clock::now();
+        is_solved_ = search(state, NO_ACTION);
+        const double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+        iterations_.push_back({threshold, node_count_, seconds});
+        if (is_solved_) {
+            return path_;
+        }
+    }
+    return {};
+}
+
+template <class State, class Heuristic>
+bool Solver<State, Heuristic>::search(State& state, const int pre_action) {
+    ++node_count_;
+    const int f_cost = state.g_cost + heuristic_(state);
+    if (f_cost > threshold_) {
+        next_threshold_ = std::min(next_threshold_, f_cost);
+        return false;
+    }
+    if (state.is_done()) {
+        return true;
+    }
+    for (int action = 0; action < State::ACTION_COUNT; ++action) {
+        if ((pre_action != NO_ACTION && action == State::inverse_action(pre_action)) || !state.is_legal_action(action)) {
+            continue;
+        }
+        typename State::UndoInfo undo_info;
+        state.step(action, undo_info);
+        path_.emplace_back(action);
+        if (search(state, action)) {
+            return true;
+        }
+        path_.pop_back();
+        state.undo(action, undo_info);
+    }
+    return false;
+}
+
+template <class State, class Heuristic>
+inline bool Solver<State, Heuristic>::is_solved() const {
+    return is_solved_;
+}
+
+template <class State, class Heuristic>
+inline const std::vector<IterationStats>& Solver<State, Heuristic>::iterations() const {
+    return iterations_;
+}
+
+template <class State, class Heuristic>
+inline int64_t Solver<State, Heuristic>::total_node_count() const {
+    int64_t total = 0;
+    for (const auto& iteration : iterations_) {
+        total += iteration.node_count;
+    }
+    return total;
+}
+
+} // namespace ida_star
@@ -0,0 +1,74 @@
+/*
+読み込み専用でメモリにマップしたファイル
+POSIX の mmap を使うので, ファイル全体を読み込まずに, 参照したページだけがディスクから読まれる
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    explicit MappedFile(const std::string& path) {
+        open(path);
+    }
+
+    ~MappedFile() {
+        close();
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // 開けなければ false
+    bool open(const std::string& path) {
+        close();
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat status;
+        if (fstat(fd, &status) == 0 && status.st_size > 0) {
+            void* data = mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+            if (data != MAP_FAILED) {
+                data_ = static_cast<const unsigned char*>(data);
+                size_ = status.st_size;
+            }
+        }
+        // マップした後はファイルを閉じてもよい
+        ::close(fd);
+        return data_ != nullptr;
+    }
+
+    void close() {
+        if (data_ != nullptr) {
+            munmap(const_cast<unsigned char*>(data_), size_);
+            data_ = nullptr;
+            size_ = 0;
+        }
+    }
+
+    bool is_open() const {
+        return data_ != nullptr;
+    }
+
+    const unsigned char* data() const {
+        return data_;
+    }
+
+    std::size_t size() const {
+        return size_;
+    }
+
+private:
+    const unsigned char* data_ = nullptr;
+    std::size_t size_ = 0;
+};
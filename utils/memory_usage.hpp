@@ -0,0 +1,35 @@
+/*
+メモリ使用量の取得
+Linux の /proc/self/status を読むので, それ以外の環境では 0 を返す
+*/
+
+#pragma once
+
+#include <fstream>
+#include <string>
+
+namespace memory_usage {
+
+// /proc/self/status の field 行の値 (kB)
+inline long read_status_kb(const std::string& field) {
+    std::ifstream ifs("/proc/self/status");
+    std::string line;
+    while (std::getline(ifs, line)) {
+        if (line.compare(0, field.size(), field) == 0 && line[field.size()] == ':') {
+            return std::stol(line.substr(field.size() + 1));
+        }
+    }
+    return 0;
+}
+
+// 現在の常駐メモリ (kB)
+inline long current_rss_kb() {
+    return read_status_kb("VmRSS");
+}
+
+// 常駐メモリの最大値 (kB)
+inline long peak_rss_kb() {
+    return read_status_kb("VmHWM");
+}
+
+} // namespace memory_usage
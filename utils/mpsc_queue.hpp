@@ -0,0 +1,58 @@
+/*
+ロックフリーな複数生産者・単一消費者のキュー
+生産者は compare_exchange で単方向リストの先頭に要素を積み, 消費者は exchange でリスト全体をまとめて取り出す
+取り出す順序は積んだ順と逆になる (順序を問わない用途向け)
+テンプレートを使用するためにヘッダに実装を書いている
+*/
+
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+template <class T>
+class MPSCQueue {
+public:
+    MPSCQueue() = default;
+
+    ~MPSCQueue() {
+        consume_all([](T&&) {});
+    }
+
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    // どのスレッドからも呼べる
+    void push(T value) {
+        Node* node = new Node{std::move(value), head_.load(std::memory_order_relaxed)};
+        while (!head_.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+
+    // 消費者のスレッドだけが呼ぶ. 積まれていたすべての要素に function を適用し, 適用した数を返す
+    template <class Function>
+    int consume_all(Function function) {
+        Node* node = head_.exchange(nullptr, std::memory_order_acquire);
+        int count = 0;
+        while (node != nullptr) {
+            Node* next = node->next;
+            function(std::move(node->value));
+            delete node;
+            node = next;
+            ++count;
+        }
+        return count;
+    }
+
+    bool empty() const {
+        return head_.load(std::memory_order_relaxed) == nullptr;
+    }
+
+private:
+    struct Node {
+        T value;
+        Node* next;
+    };
+
+    std::atomic<Node*> head_ = nullptr;
+};
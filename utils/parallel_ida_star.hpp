@@ -0,0 +1,264 @@
+/*
+並列反復深化 A* 探索
+閾値ごとに, ルートから f コストが閾値以下の節点を幅優先で数千個程度まで広げたもの (フロンティア) を作り,
+フロンティアの節点を根とする部分木の探索をタスクとしてワークスティーリング方式のスレッドプールに分配する
+部分木の探索は ida_star::Solver と同じく step / undo による深さ優先探索で, スレッドごとに状態を持つ
+解が見つかると atomic なフラグを立て, 他のスレッドは次の節点で探索を打ち切る
+閾値を超えた f コストの最小値はスレッドごとに求め, 閾値の探索が終わった後にまとめる
+f コストが経路に沿って減らない (h コストが単調な) ことを前提に, フロンティアより上の節点で閾値を超えたものは枝刈りする
+
+状態に求めるものは ida_star::Solver と同じ
+テンプレートを使用するためにヘッダに実装を書いている
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "ida_star.hpp"
+#include "thread_pool.hpp"
+
+namespace ida_star {
+
+// 1 回の閾値での並列探索の記録
+struct ParallelIterationStats {
+    int threshold;
+    int64_t node_count;
+    double seconds;
+    // フロンティアの節点数
+    std::size_t frontier_size;
+    // スレッドごとの探索節点数の最大値 / 平均値
+    double imbalance;
+};
+
+template <class State, class Heuristic = StateHeuristic>
+class ParallelSolver {
+public:
+    // frontier_size: フロンティアの節点数の目安
+    ParallelSolver(const int thread_count, const std::size_t frontier_size = 4096, Heuristic heuristic = Heuristic())
+        : pool_(thread_count), frontier_size_(frontier_size), heuristic_(heuristic), thread_stats_(pool_.thread_count())
+    {}
+
+    std::vector<int> solve(const State& state, const int max_threshold = INT_MAX);
+
+    bool is_solved() const;
+
+    const std::vector<ParallelIterationStats>& iterations() const;
+
+    int64_t total_node_count() const;
+
+    // 直前の solve でのスレッドごとの探索節点数 (フロンティアを作るための節点は含まない)
+    std::vector<int64_t> thread_node_counts() const;
+
+    int64_t steal_count() const;
+
+private:
+    static constexpr int NO_ACTION = -1;
+    static constexpr int NO_PARENT = -1;
+
+    // フロンティアを作るときの節点. 経路は親の添字で辿る
+    struct FrontierNode {
+        State state;
+        int parent;
+        int action;
+    };
+
+    // false sharing を避けるため, スレッドごとの記録をキャッシュラインに揃える
+    struct alignas(64) ThreadStats {
+        int64_t node_count = 0;
+        int64_t total_node_count = 0;
+        int next_threshold = INT_MAX;
+    };
+
+    WorkStealingPool pool_;
+    std::size_t frontier_size_;
+    Heuristic heuristic_;
+    std::vector<ThreadStats> thread_stats_;
+    std::vector<ParallelIterationStats> iterations_;
+    std::atomic<bool> is_solved_ = false;
+    std::mutex solution_mutex_;
+    std::vector<int> solution_;
+
+    // 閾値以下の節点を幅優先で広げる. ゴールが見つかればその添字, 見つからなければ -1
+    int build_frontier(std::vector<FrontierNode>& nodes, std::vector<int>& frontier, const int threshold, int& next_threshold, int64_t& node_count);
+
+    std::vector<int> get_path(const std::vector<FrontierNode>& nodes, int index) const;
+
+    bool search(State& state, const int pre_action, const int threshold, ThreadStats& stats, std::vector<int>& path);
+};
+
+template <class State, class Heuristic>
+int ParallelSolver<State, Heuristic>::build_frontier(std::vector<FrontierNode>& nodes, std::vector<int>& frontier, const int threshold, int& next_threshold, int64_t& node_count) {
+    frontier = {0};
+    while (!frontier.empty() && frontier.size() < frontier_size_) {
+        std::vector<int> next_frontier;
+        for (const int index : frontier) {
+            ++node_count;
+            const int f_cost = nodes[index].state.g_cost + heuristic_(nodes[index].state);
+            if (f_cost > threshold) {
+                next_threshold = std::min(next_threshold, f_cost);
+                continue;
+            }
+            if (nodes[index].state.is_done()) {
+                return index;
+            }
+            for (int action = 0; action < State::ACTION_COUNT; ++action) {
+                const int pre_action = nodes[index].action;
+                if ((pre_action != NO_ACTION && action == State::inverse_action(pre_action)) || !nodes[index].state.is_legal_action(action)) {
+                    continue;
+                }
+                State next_state = nodes[index].state;
+                next_state.step(action);
+                next_frontier.emplace_back(nodes.size());
+                nodes.push_back({next_state, index, action});
+            }
+        }
+        frontier = std::move(next_frontier);
+    }
+    return -1;
+}
+
+template <class State, class Heuristic>
+std::vector<int> ParallelSolver<State, Heuristic>::get_path(const std::vector<FrontierNode>& nodes, int index) const {
+    std::vector<int> path;
+    for (; nodes[index].parent != NO_PARENT; index = nodes[index].parent) {
+        path.emplace_back(nodes[index].action);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+template <class State, class Heuristic>
+std::vector<int> ParallelSolver<State, Heuristic>::solve(const State& state, const int max_threshold) {
+    iterations_.clear();
+    solution_.clear();
+    is_solved_ = false;
+    for (auto& stats : thread_stats_) {
+        stats.total_node_count = 0;
+    }
+    int threshold = state.g_cost + heuristic_(state);
+    while (threshold <= max_threshold) {
+        const auto start_time = std::chrono::high_resolution_clock::now();
+        std::vector<FrontierNode> nodes = {{state, NO_PARENT, NO_ACTION}};
+        std::vector<int> frontier;
+        int next_threshold = INT_MAX;
+        int64_t node_count = 0;
+        // フロンティアの中でゴールが見つかった場合も, 前の反復の記録を集計しないように先に消す
+        for (auto& stats : thread_stats_) {
+            stats.node_count = 0;
+            stats.next_threshold = INT_MAX;
+        }
+        if (const int goal = build_frontier(nodes, frontier, threshold, next_threshold, node_count); goal >= 0) {
+            solution_ = get_path(nodes, goal);
+            is_solved_ = true;
+        } else {
+            for (const int index : frontier) {
+                pool_.submit([this, &nodes, index, threshold] {
+                    if (is_solved_.load(std::memory_order_relaxed)) {
+                        return;
+                    }
+                    auto& stats = thread_stats_[WorkStealingPool::thread_index()];
+                    State root = nodes[index].state;
+                    std::vector<int> path;
+                    if (search(root, nodes[index].action, threshold, stats, path)) {
+                        std::lock_guard lock(solution_mutex_);
+                        if (!is_solved_.load()) {
+                            solution_ = get_path(nodes, index);
+                            solution_.insert(solution_.end(), path.begin(), path.end());
+                            is_solved_ = true;
+                        }
+                    }
+                });
+            }
+            pool_.wait_idle();
+        }
+        int64_t max_node_count = 0;
+        int64_t thread_node_count = 0;
+        for (auto& stats : thread_stats_) {
+            next_threshold = std::min(next_threshold, stats.next_threshold);
+            max_node_count = std::max(max_node_count, stats.node_count);
+            thread_node_count += stats.node_count;
+            stats.total_node_count += stats.node_count;
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+        const double imbalance = thread_node_count ? static_cast<double>(max_node_count) * thread_stats_.size() / thread_node_count : 1;
+        iterations_.push_back({threshold, node_count + thread_node_count, seconds, frontier.size(), imbalance});
+        if (is_solved_) {
+            return solution_;
+        }
+        threshold = next_threshold;
+    }
+    return {};
+}
+
+template <class State, class Heuristic>
+bool ParallelSolver<State, Heuristic>::search(State& state, const int pre_action, const int threshold, ThreadStats& stats, std::vector<int>& path) {
+    ++stats.node_count;
+    const int f_cost = state.g_cost + heuristic_(state);
+    if (f_cost > threshold) {
+        stats.next_threshold = std::min(stats.next_threshold, f_cost);
+        return false;
+    }
+    if (state.is_done()) {
+        return true;
+    }
+    for (int action = 0; action < State::ACTION_COUNT; ++action) {
+        if ((pre_action != NO_ACTION && action == State::inverse_action(pre_action)) || !state.is_legal_action(action)) {
+            continue;
+        }
+        // 他のスレッドが解を見つけていれば打ち切る
+        if (is_solved_.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        typename State::UndoInfo undo_info;
+        state.step(action, undo_info);
+        path.emplace_back(action);
+        if (search(state, action, threshold, stats, path)) {
+            return true;
+        }
+        path.pop_back();
+        state.undo(action, undo_info);
+    }
+    return false;
+}
+
+template <class State, class Heuristic>
+inline bool ParallelSolver<State, Heuristic>::is_solved() const {
+    return is_solved_;
+}
+
+template <class State, class Heuristic>
+inline const std::vector<ParallelIterationStats>& ParallelSolver<State, Heuristic>::iterations() const {
+    return iterations_;
+}
+
+template <class State, class Heuristic>
+inline int64_t ParallelSolver<State, Heuristic>::total_node_count() const {
+    int64_t total = 0;
+    for (const auto& iteration : iterations_) {
+        total += iteration.node_count;
+    }
+    return total;
+}
+
+template <class State, class Heuristic>
+inline std::vector<int64_t> ParallelSolver<State, Heuristic>::thread_node_counts() const {
+    std::vector<int64_t> counts;
+    for (const auto& stats : thread_stats_) {
+        counts.emplace_back(stats.total_node_count);
+    }
+    return counts;
+}
+
+template <class State, class Heuristic>
+inline int64_t ParallelSolver<State, Heuristic>::steal_count() const {
+    return pool_.steal_count();
+}
+
+} // namespace ida_star
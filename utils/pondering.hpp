@@ -0,0 +1,188 @@
+/*
+相手の手番の間も探索を続ける (ポンダリング) MCTS のプレイヤー
+手を返した後, その手を指した局面をルートにした木 (utils/generic_search の Mcts) をバックグラウンドのスレッドで探索し続ける
+次に呼ばれたら停止フラグを立てて join し, 相手が指した後の局面をルートの子から探す
+  ポンダーヒット: 相手の手がポンダリング中に最も訪問した手 (予想手) と一致した
+  ポンダーミス  : 一致しなかった. 実際の手の部分木だけが残り, 残りの木は捨てる
+どちらの場合も実際の手の部分木を新しいルートにするので, ポンダリングのうちその部分木に費やした分が次の手の探索に上乗せされる
+テンプレートを使用するためにヘッダに実装を書いている
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "generic_search.hpp"
+#include "time_keeper.hpp"
+
+namespace pondering {
+
+struct PonderStats {
+    // 手を返した回数
+    int move_count = 0;
+    // ポンダリングしてから呼ばれた回数と, そのうちポンダーヒットした回数
+    int ponder_count = 0;
+    int hit_count = 0;
+    // ポンダリングしていた時間の合計 (秒)
+    double ponder_seconds = 0.;
+    // ポンダリングの時間のうち, 実際の手の部分木に費やした分 (ルートの訪問回数の比で按分) の合計 (秒)
+    double kept_seconds = 0.;
+    // 手を決めたときのルートの訪問回数の合計
+    int64_t root_count = 0;
+
+    double hit_rate() const;
+
+    // 1 手あたりの実質的な思考時間の上乗せ (秒)
+    double extra_seconds_per_move() const;
+
+    PonderStats& operator+=(const PonderStats& other);
+};
+
+inline double PonderStats::hit_rate() const {
+    return ponder_count ? static_cast<double>(hit_count) / ponder_count : 0.;
+}
+
+inline double PonderStats::extra_seconds_per_move() const {
+    return move_count ? kept_seconds / move_count : 0.;
+}
+
+inline PonderStats& PonderStats::operator+=(const PonderStats& other) {
+    move_count += other.move_count;
+    ponder_count += other.ponder_count;
+    hit_count += other.hit_count;
+    ponder_seconds += other.ponder_seconds;
+    kept_seconds += other.kept_seconds;
+    root_count += other.root_count;
+    return *this;
+}
+
+// 1 手に think_time_ms ミリ秒探索する MCTS のプレイヤー
+// is_pondering が false なら相手の手番には探索しない (木の引き継ぎはする. 比較用)
+template <generic_search::GameState State, class Playout = generic_search::RandomPlayout>
+    requires generic_search::HashableState<State>
+class MctsPlayer {
+public:
+    using Action = generic_search::ActionOf<State>;
+
+    MctsPlayer(const int64_t think_time_ms, const bool is_pondering, Playout playout = Playout())
+        : mcts_(std::move(playout)), think_time_ms_(think_time_ms), is_pondering_(is_pondering) {}
+
+    ~MctsPlayer();
+
+    MctsPlayer(const MctsPlayer&) = delete;
+    MctsPlayer& operator=(const MctsPlayer&) = delete;
+
+    Action operator()(const State& state);
+
+    const PonderStats& stats() const;
+
+private:
+    generic_search::Mcts<State, Playout> mcts_;
+    int64_t think_time_ms_;
+    bool is_pondering_;
+    std::thread ponder_thread_;
+    std::atomic<bool> is_ponder_stopped_ = false;
+    std::chrono::high_resolution_clock::time_point ponder_start_time_;
+    // ポンダリングを始めたときのルートとその子の訪問回数
+    int ponder_start_root_count_ = 0;
+    std::vector<int> ponder_start_child_counts_;
+    PonderStats stats_;
+
+    void start_pondering();
+
+    // ポンダリングのスレッドを止めて, ポンダリングしていた時間 (秒) を返す
+    double stop_pondering();
+
+    // ルートの子のうち state と同じ局面の添字. 無ければ -1
+    int child_index(const State& state) const;
+};
+
+template <generic_search::GameState State, class Playout>
+    requires generic_search::HashableState<State>
+MctsPlayer<State, Playout>::~MctsPlayer() {
+    if (ponder_thread_.joinable()) {
+        stop_pondering();
+    }
+}
+
+template <generic_search::GameState State, class Playout>
+    requires generic_search::HashableState<State>
+void MctsPlayer<State, Playout>::start_pondering() {
+    is_ponder_stopped_.store(false);
+    ponder_start_root_count_ = mcts_.root_count();
+    ponder_start_child_counts_ = mcts_.child_counts();
+    ponder_start_time_ = std::chrono::high_resolution_clock::now();
+    ponder_thread_ = std::thread([this] {
+        mcts_.search([this] { return is_ponder_stopped_.load(std::memory_order_relaxed); });
+    });
+}
+
+template <generic_search::GameState State, class Playout>
+    requires generic_search::HashableState<State>
+double MctsPlayer<State, Playout>::stop_pondering() {
+    is_ponder_stopped_.store(true);
+    ponder_thread_.join();
+    return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - ponder_start_time_).count();
+}
+
+template <generic_search::GameState State, class Playout>
+    requires generic_search::HashableState<State>
+auto MctsPlayer<State, Playout>::operator()(const State& state) -> Action {
+    if (ponder_thread_.joinable()) {
+        const double ponder_seconds = stop_pondering();
+        const auto child_counts = mcts_.child_counts();
+        const int ponder_visit_count = mcts_.root_count() - ponder_start_root_count_;
+        ++stats_.ponder_count;
+        stats_.ponder_seconds += ponder_seconds;
+        if (const int index = child_index(state); index >= 0) {
+            // ポンダリング中のルート (相手の手番) で最も訪問した手が予想手
+            stats_.hit_count += std::max_element(child_counts.begin(), child_counts.end()) - child_counts.begin() == index;
+            if (ponder_visit_count > 0) {
+                stats_.kept_seconds += ponder_seconds * (child_counts[index] - ponder_start_child_counts_[index]) / ponder_visit_count;
+            }
+        }
+    }
+    mcts_.advance(state);
+
+    const TimeKeeper time_keeper(think_time_ms_);
+    mcts_.search([&time_keeper] { return time_keeper.is_time_over(); });
+    const Action action = mcts_.best_action();
+    ++stats_.move_count;
+    stats_.root_count += mcts_.root_count();
+
+    State next_state = state;
+    next_state.step(action);
+    mcts_.advance(next_state);
+    if (is_pondering_ && !next_state.is_done()) {
+        start_pondering();
+    }
+    return action;
+}
+
+template <generic_search::GameState State, class Playout>
+    requires generic_search::HashableState<State>
+int MctsPlayer<State, Playout>::child_index(const State& state) const {
+    const auto hash_value = generic_search::hash_of(state);
+    const auto legal_actions = mcts_.root_state().legal_actions();
+    for (int index = 0; index < static_cast<int>(legal_actions.size()); ++index) {
+        State child_state = mcts_.root_state();
+        child_state.step(legal_actions[index]);
+        if (generic_search::hash_of(child_state) == hash_value) {
+            return index;
+        }
+    }
+    return -1;
+}
+
+template <generic_search::GameState State, class Playout>
+    requires generic_search::HashableState<State>
+inline const PonderStats& MctsPlayer<State, Playout>::stats() const {
+    return stats_;
+}
+
+} // namespace pondering
@@ -0,0 +1,96 @@
+#include "probcut.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+namespace probcut {
+
+Parameter fit(const int stage, const int shallow_depth, const int deep_depth, const std::vector<std::pair<double, double>>& samples) {
+    Parameter parameter = {stage, shallow_depth, deep_depth, 1.0, 0.0, 0.0};
+    const double n = samples.size();
+    if (samples.size() < 2) {
+        return parameter;
+    }
+    double sum_x = 0, sum_y = 0, sum_xx = 0, sum_xy = 0;
+    for (const auto& [x, y] : samples) {
+        sum_x += x;
+        sum_y += y;
+        sum_xx += x * x;
+        sum_xy += x * y;
+    }
+    const double denominator = n * sum_xx - sum_x * sum_x;
+    if (denominator != 0) {
+        parameter.a = (n * sum_xy - sum_x * sum_y) / denominator;
+    }
+    parameter.b = (sum_y - parameter.a * sum_x) / n;
+    double sum_squared_error = 0;
+    for (const auto& [x, y] : samples) {
+        const double error = y - (parameter.a * x + parameter.b);
+        sum_squared_error += error * error;
+    }
+    parameter.sigma = std::sqrt(sum_squared_error / (n - 1));
+    return parameter;
+}
+
+void ParameterTable::add(const Parameter& parameter) {
+    auto& parameters = parameters_[parameter.stage][parameter.deep_depth];
+    parameters.emplace_back(parameter);
+    std::sort(parameters.begin(), parameters.end(), [](const Parameter& p1, const Parameter& p2) {
+        return p1.shallow_depth < p2.shallow_depth;
+    });
+}
+
+bool ParameterTable::empty() const {
+    for (const auto& parameters_per_stage : parameters_) {
+        for (const auto& parameters : parameters_per_stage) {
+            if (!parameters.empty()) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// 1 行に "stage shallow_depth deep_depth a b sigma" を並べる. '#' から始まる行は無視
+bool ParameterTable::load(const std::string& path) {
+    std::ifstream ifs(path);
+    if (!ifs) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(ifs, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream iss(line);
+        Parameter parameter;
+        if (!(iss >> parameter.stage >> parameter.shallow_depth >> parameter.deep_depth >> parameter.a >> parameter.b >> parameter.sigma)) {
+            return false;
+        }
+        if (parameter.stage < 0 || parameter.stage >= STAGE_COUNT || parameter.deep_depth > MAX_DEPTH || parameter.shallow_depth >= parameter.deep_depth) {
+            return false;
+        }
+        add(parameter);
+    }
+    return true;
+}
+
+bool ParameterTable::save(const std::string& path) const {
+    std::ofstream ofs(path);
+    if (!ofs) {
+        return false;
+    }
+    ofs << "# stage shallow_depth deep_depth a b sigma\n";
+    for (const auto& parameters_per_stage : parameters_) {
+        for (const auto& parameters : parameters_per_stage) {
+            for (const auto& p : parameters) {
+                ofs << p.stage << ' ' << p.shallow_depth << ' ' << p.deep_depth << ' ' << p.a << ' ' << p.b << ' ' << p.sigma << '\n';
+            }
+        }
+    }
+    return static_cast<bool>(ofs);
+}
+
+} // namespace probcut
@@ -0,0 +1,64 @@
+/*
+ProbCut / Multi-ProbCut のパラメータ
+深さ deep_depth の探索の評価値を, 深さ shallow_depth の探索の評価値 v から a * v + b と予測する
+予測誤差の標準偏差 sigma とともに, (ステージ, deep_depth) ごとに複数の shallow_depth の組を保持する
+ステージはオセロの空きマス数から決める
+*/
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace probcut {
+
+// 予測を適用する深い探索の最大の深さ
+static constexpr int MAX_DEPTH = 16;
+// ステージ数. 空きマス 60 を STAGE_WIDTH ずつに区切る
+static constexpr int STAGE_COUNT = 6;
+static constexpr int STAGE_WIDTH = 10;
+
+inline int get_stage(const int empties) {
+    const int stage = (60 - empties) / STAGE_WIDTH;
+    return stage < 0 ? 0 : (stage >= STAGE_COUNT ? STAGE_COUNT - 1 : stage);
+}
+
+struct Parameter {
+    int stage;
+    int shallow_depth;
+    int deep_depth;
+    double a;
+    double b;
+    double sigma;
+};
+
+// (shallow_score, deep_score) の組から最小二乗法で a, b, sigma を求める
+Parameter fit(const int stage, const int shallow_depth, const int deep_depth, const std::vector<std::pair<double, double>>& samples);
+
+class ParameterTable {
+public:
+    void add(const Parameter& parameter);
+
+    // stage, deep_depth に対する (浅い探索の深さが浅い順の) パラメータ列
+    const std::vector<Parameter>& find(const int stage, const int deep_depth) const;
+
+    bool empty() const;
+
+    // 読み書きに失敗したら false
+    bool load(const std::string& path);
+    bool save(const std::string& path) const;
+
+private:
+    std::vector<Parameter> parameters_[STAGE_COUNT][MAX_DEPTH + 1];
+};
+
+inline const std::vector<Parameter>& ParameterTable::find(const int stage, const int deep_depth) const {
+    static const std::vector<Parameter> no_parameters;
+    if (deep_depth > MAX_DEPTH) {
+        return no_parameters;
+    }
+    return parameters_[stage][deep_depth];
+}
+
+} // namespace probcut
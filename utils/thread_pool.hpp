@@ -0,0 +1,168 @@
+/*
+ワークスティーリング方式のスレッドプール
+スレッドごとに両端キューを持ち, 自分のキューには末尾から積んで末尾から取り出す (深さ優先に近い順で処理する)
+自分のキューが空になったら, 他のスレッドのキューの先頭 (大きな部分木であることが多い) から盗む
+タスクの中から submit すると, 実行中のスレッドのキューに積まれる
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkStealingPool(const int thread_count = std::thread::hardware_concurrency());
+
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    void submit(Task task);
+
+    // 積まれたタスク (タスクから積まれたものを含む) がすべて終わるまで待つ
+    void wait_idle();
+
+    int thread_count() const;
+
+    // 実行中のスレッドの番号 (0 ~ thread_count - 1). プールの外からは -1
+    static int thread_index();
+
+    // 他のスレッドから盗んだタスクの数
+    int64_t steal_count() const;
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable task_available_;
+    std::condition_variable idle_;
+    // 積まれてまだ終わっていないタスクの数
+    std::atomic<int64_t> pending_count_ = 0;
+    std::atomic<int64_t> steal_count_ = 0;
+    std::atomic<unsigned int> next_queue_ = 0;
+    bool is_stopped_ = false;
+
+    static thread_local int thread_index_;
+
+    bool try_pop(const int index, Task& task);
+    bool try_steal(const int index, Task& task);
+    void run(const int index);
+};
+
+inline thread_local int WorkStealingPool::thread_index_ = -1;
+
+inline WorkStealingPool::WorkStealingPool(const int thread_count) {
+    const int count = thread_count > 0 ? thread_count : 1;
+    for (int index = 0; index < count; ++index) {
+        queues_.emplace_back(std::make_unique<WorkQueue>());
+    }
+    for (int index = 0; index < count; ++index) {
+        threads_.emplace_back([this, index] { run(index); });
+    }
+}
+
+inline WorkStealingPool::~WorkStealingPool() {
+    wait_idle();
+    {
+        std::lock_guard lock(mutex_);
+        is_stopped_ = true;
+    }
+    task_available_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+// プールの外からは各スレッドのキューに順番に配る
+inline void WorkStealingPool::submit(Task task) {
+    const int index = thread_index_ >= 0 ? thread_index_ : next_queue_++ % queues_.size();
+    pending_count_.fetch_add(1);
+    {
+        std::lock_guard lock(queues_[index]->mutex);
+        queues_[index]->tasks.emplace_back(std::move(task));
+    }
+    {
+        // 待機中のスレッドが通知を取りこぼさないよう, mutex_ を取ってから起こす
+        std::lock_guard lock(mutex_);
+    }
+    task_available_.notify_one();
+}
+
+inline void WorkStealingPool::wait_idle() {
+    std::unique_lock lock(mutex_);
+    idle_.wait(lock, [this] { return pending_count_.load() == 0; });
+}
+
+inline int WorkStealingPool::thread_count() const {
+    return threads_.size();
+}
+
+inline int WorkStealingPool::thread_index() {
+    return thread_index_;
+}
+
+inline int64_t WorkStealingPool::steal_count() const {
+    return steal_count_.load();
+}
+
+inline bool WorkStealingPool::try_pop(const int index, Task& task) {
+    auto& queue = *queues_[index];
+    std::lock_guard lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+inline bool WorkStealingPool::try_steal(const int index, Task& task) {
+    const int count = queues_.size();
+    for (int offset = 1; offset < count; ++offset) {
+        auto& queue = *queues_[(index + offset) % count];
+        std::lock_guard lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            steal_count_.fetch_add(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+inline void WorkStealingPool::run(const int index) {
+    thread_index_ = index;
+    while (true) {
+        Task task;
+        if (try_pop(index, task) || try_steal(index, task)) {
+            task();
+            if (pending_count_.fetch_sub(1) == 1) {
+                std::lock_guard lock(mutex_);
+                idle_.notify_all();
+            }
+            continue;
+        }
+        std::unique_lock lock(mutex_);
+        if (is_stopped_) {
+            return;
+        }
+        // 積まれたがまだ誰も取っていないタスクがあるかもしれないので, 短い間隔で見直す
+        task_available_.wait_for(lock, std::chrono::milliseconds(1));
+    }
+}
@@ -1,26 +1,76 @@
 /*
 時間計測器
+ハードリミット (これを超えたら探索を即座に打ち切る) とソフトリミット (これを超えたら次の反復を始めない) を持つ
 */
 
 #pragma once
 
+#include <algorithm>
 #include <chrono>
 
 class TimeKeeper {
 public:
+    // time_threshold はミリ秒. ソフトリミットはハードリミットと同じ
     explicit TimeKeeper(const int64_t time_threshold)
+        : TimeKeeper(std::chrono::milliseconds(time_threshold), std::chrono::milliseconds(time_threshold))
+    {}
+
+    TimeKeeper(const std::chrono::microseconds hard_threshold, const std::chrono::microseconds soft_threshold)
         : start_time_(std::chrono::high_resolution_clock::now()),
-          time_threshold_(time_threshold)
+          time_threshold_(hard_threshold.count()),
+          soft_time_threshold_(std::min(soft_threshold.count(), hard_threshold.count()))
     {}
 
     bool is_time_over() const;
 
+    bool is_soft_time_over() const;
+
+    int64_t elapsed_microseconds() const;
+
+    int64_t remaining_microseconds() const;
+
+    int64_t soft_remaining_microseconds() const;
+
+    int64_t soft_threshold_microseconds() const;
+
+    void set_soft_threshold(const std::chrono::microseconds soft_threshold);
+
 private:
     std::chrono::high_resolution_clock::time_point start_time_;
+    // 単位はマイクロ秒
     int64_t time_threshold_;
+    int64_t soft_time_threshold_;
 };
 
 inline bool TimeKeeper::is_time_over() const {
+    return elapsed_microseconds() >= time_threshold_;
+}
+
+inline bool TimeKeeper::is_soft_time_over() const {
+    return elapsed_microseconds() >= soft_time_threshold_;
+}
+
+// 計測開始からの経過時間 (マイクロ秒)
+inline int64_t TimeKeeper::elapsed_microseconds() const {
     auto diff = std::chrono::high_resolution_clock::now() - start_time_;
-    return std::chrono::duration_cast<std::chrono::milliseconds>(diff).count() >= time_threshold_;
-}
\ No newline at end of file
+    return std::chrono::duration_cast<std::chrono::microseconds>(diff).count();
+}
+
+// ハードリミットまでの残り時間 (マイクロ秒)
+inline int64_t TimeKeeper::remaining_microseconds() const {
+    return time_threshold_ - elapsed_microseconds();
+}
+
+// ソフトリミットまでの残り時間 (マイクロ秒)
+inline int64_t TimeKeeper::soft_remaining_microseconds() const {
+    return soft_time_threshold_ - elapsed_microseconds();
+}
+
+inline int64_t TimeKeeper::soft_threshold_microseconds() const {
+    return soft_time_threshold_;
+}
+
+// ソフトリミットはハードリミットを超えない
+inline void TimeKeeper::set_soft_threshold(const std::chrono::microseconds soft_threshold) {
+    soft_time_threshold_ = std::min(soft_threshold.count(), time_threshold_);
+}
@@ -0,0 +1,221 @@
+/*
+トランスポジションテーブル
+オープンアドレス法による固定サイズのハッシュ表で, 1 つのバケットをキャッシュライン (64 バイト) に揃えて確保する
+キーのハッシュ値でバケットを決め, バケット内の空きエントリに書き込む
+バケットが埋まっていれば, 置換方針 ReplacementPolicy の優先度が最も低いエントリを上書きする
+そのため書き込んだエントリが後で消えていることがあり, 探索側は見つからなかった場合も正しく動く必要がある
+テンプレートを使用するためにヘッダに実装を書いている
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "zobrist_hashing.hpp"
+
+// 置換方針. priority が最も小さいエントリが上書きされる
+// age は, エントリを書き込んでから new_generation が呼ばれた回数
+namespace replacement {
+
+// 常に上書きする
+struct Always {
+    template <class Entry>
+    static int priority(const Entry&, const int) {
+        return 0;
+    }
+};
+
+// 探索深さ (Entry::depth) の深いエントリを残す
+struct DepthPreferred {
+    template <class Entry>
+    static int priority(const Entry& entry, const int) {
+        return entry.depth;
+    }
+};
+
+// 古い探索のエントリほど優先度を下げる
+struct Aging {
+    static constexpr int AGE_WEIGHT = 4;
+
+    template <class Entry>
+    static int priority(const Entry& entry, const int age) {
+        return entry.depth - AGE_WEIGHT * age;
+    }
+};
+
+} // namespace replacement
+
+template <class Entry, class ReplacementPolicy = replacement::Always>
+class TranspositionTable {
+public:
+    using HashValue = zobrist_hashing::HashValue;
+
+    // size_mb: 表全体の大きさ (MB). バケット数は 2 のべき乗に切り下げる
+    explicit TranspositionTable(const std::size_t size_mb);
+
+    Entry* find(const HashValue key);
+    const Entry* find(const HashValue key) const;
+
+    // key のエントリを返す. 無ければ置換方針に従ってエントリを確保し, 値初期化して返す
+    Entry& operator[](const HashValue key);
+
+    void store(const HashValue key, const Entry& entry);
+
+    // key の入るバケットをキャッシュに読み込んでおく
+    void prefetch(const HashValue key) const;
+
+    void clear();
+
+    // 探索を 1 回進める. Aging ではこれより前に書き込まれたエントリの優先度が下がる
+    void new_generation();
+
+    std::size_t size() const;
+    std::size_t capacity() const;
+    std::size_t size_in_bytes() const;
+
+private:
+    static constexpr std::size_t CACHE_LINE_SIZE = 64;
+    static constexpr std::size_t SLOT_COUNT = std::max<std::size_t>(1, CACHE_LINE_SIZE / (sizeof(HashValue) + sizeof(uint8_t) + sizeof(Entry)));
+
+    // パディングが入らないよう, キー・世代・エントリを別々の配列に並べる
+    // generations[i] が 0 なら空き
+    struct alignas(CACHE_LINE_SIZE) Bucket {
+        HashValue keys[SLOT_COUNT];
+        Entry entries[SLOT_COUNT];
+        uint8_t generations[SLOT_COUNT];
+    };
+
+    std::vector<Bucket> buckets_;
+    HashValue mask_;
+    uint8_t generation_ = 1;
+    std::size_t size_ = 0;
+
+    Bucket& bucket(const HashValue key);
+    const Bucket& bucket(const HashValue key) const;
+    int age(const uint8_t generation) const;
+};
+
+template <class Entry, class ReplacementPolicy>
+TranspositionTable<Entry, ReplacementPolicy>::TranspositionTable(const std::size_t size_mb) {
+    std::size_t bucket_count = 1;
+    while (bucket_count * 2 * sizeof(Bucket) <= size_mb * 1024 * 1024) {
+        bucket_count *= 2;
+    }
+    buckets_.resize(bucket_count);
+    mask_ = bucket_count - 1;
+    clear();
+}
+
+template <class Entry, class ReplacementPolicy>
+inline auto TranspositionTable<Entry, ReplacementPolicy>::bucket(const HashValue key) -> Bucket& {
+    return buckets_[key & mask_];
+}
+
+template <class Entry, class ReplacementPolicy>
+inline auto TranspositionTable<Entry, ReplacementPolicy>::bucket(const HashValue key) const -> const Bucket& {
+    return buckets_[key & mask_];
+}
+
+template <class Entry, class ReplacementPolicy>
+inline int TranspositionTable<Entry, ReplacementPolicy>::age(const uint8_t generation) const {
+    // generation は 1 ~ 255 を循環する
+    return (generation_ - generation + 255) % 255;
+}
+
+template <class Entry, class ReplacementPolicy>
+inline Entry* TranspositionTable<Entry, ReplacementPolicy>::find(const HashValue key) {
+    auto& b = bucket(key);
+    for (std::size_t i = 0; i < SLOT_COUNT; ++i) {
+        if (b.generations[i] && b.keys[i] == key) {
+            return &b.entries[i];
+        }
+    }
+    return nullptr;
+}
+
+template <class Entry, class ReplacementPolicy>
+inline const Entry* TranspositionTable<Entry, ReplacementPolicy>::find(const HashValue key) const {
+    const auto& b = bucket(key);
+    for (std::size_t i = 0; i < SLOT_COUNT; ++i) {
+        if (b.generations[i] && b.keys[i] == key) {
+            return &b.entries[i];
+        }
+    }
+    return nullptr;
+}
+
+template <class Entry, class ReplacementPolicy>
+inline Entry& TranspositionTable<Entry, ReplacementPolicy>::operator[](const HashValue key) {
+    auto& b = bucket(key);
+    // 空きエントリを優先し, 無ければ優先度が最も低いエントリを上書きする
+    std::size_t victim = SLOT_COUNT;
+    int victim_priority = 0;
+    for (std::size_t i = 0; i < SLOT_COUNT; ++i) {
+        if (!b.generations[i]) {
+            if (victim == SLOT_COUNT || b.generations[victim]) {
+                victim = i;
+            }
+            continue;
+        }
+        if (b.keys[i] == key) {
+            return b.entries[i];
+        }
+        if (victim == SLOT_COUNT || b.generations[victim]) {
+            const int priority = ReplacementPolicy::priority(b.entries[i], age(b.generations[i]));
+            if (victim == SLOT_COUNT || priority < victim_priority) {
+                victim = i;
+                victim_priority = priority;
+            }
+        }
+    }
+    if (!b.generations[victim]) {
+        ++size_;
+    }
+    b.keys[victim] = key;
+    b.generations[victim] = generation_;
+    b.entries[victim] = Entry();
+    return b.entries[victim];
+}
+
+template <class Entry, class ReplacementPolicy>
+inline void TranspositionTable<Entry, ReplacementPolicy>::store(const HashValue key, const Entry& entry) {
+    (*this)[key] = entry;
+}
+
+template <class Entry, class ReplacementPolicy>
+inline void TranspositionTable<Entry, ReplacementPolicy>::prefetch(const HashValue key) const {
+    __builtin_prefetch(&bucket(key));
+}
+
+template <class Entry, class ReplacementPolicy>
+void TranspositionTable<Entry, ReplacementPolicy>::clear() {
+    for (auto& bucket : buckets_) {
+        std::fill(std::begin(bucket.generations), std::end(bucket.generations), 0);
+    }
+    size_ = 0;
+}
+
+template <class Entry, class ReplacementPolicy>
+inline void TranspositionTable<Entry, ReplacementPolicy>::new_generation() {
+    generation_ = generation_ == 255 ? 1 : generation_ + 1;
+}
+
+// 使用中のエントリ数
+template <class Entry, class ReplacementPolicy>
+inline std::size_t TranspositionTable<Entry, ReplacementPolicy>::size() const {
+    return size_;
+}
+
+// 格納できるエントリ数
+template <class Entry, class ReplacementPolicy>
+inline std::size_t TranspositionTable<Entry, ReplacementPolicy>::capacity() const {
+    return buckets_.size() * SLOT_COUNT;
+}
+
+template <class Entry, class ReplacementPolicy>
+inline std::size_t TranspositionTable<Entry, ReplacementPolicy>::size_in_bytes() const {
+    return buckets_.size() * sizeof(Bucket);
+}
@@ -0,0 +1,41 @@
+/*
+ゾブリストハッシュ用の乱数表
+固定シードの splitmix64 で 64 ビットの乱数をコンパイル時に生成するので,
+起動時の初期化が不要で, 実行ごと・プロセスごとに同じハッシュ値になる
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace zobrist_hashing {
+
+using HashValue = uint64_t;
+
+// splitmix64 で state を進めて次の乱数を返す
+constexpr HashValue splitmix64(HashValue& state) {
+    state += 0x9E3779B97F4A7C15;
+    HashValue z = state;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+    return z ^ (z >> 31);
+}
+
+// keys[piece][square] で引く乱数表
+template <std::size_t PieceCount, std::size_t SquareCount>
+using KeyTable = std::array<std::array<HashValue, SquareCount>, PieceCount>;
+
+template <std::size_t PieceCount, std::size_t SquareCount>
+constexpr KeyTable<PieceCount, SquareCount> make_key_table(HashValue seed) {
+    KeyTable<PieceCount, SquareCount> keys{};
+    for (auto& keys_per_piece : keys) {
+        for (auto& key : keys_per_piece) {
+            key = splitmix64(seed);
+        }
+    }
+    return keys;
+}
+
+} // namespace zobrist_hashing